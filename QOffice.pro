@@ -12,10 +12,15 @@
 ###########################################################
 TARGET   = QOffice
 TEMPLATE = lib
-QT      += widgets uiplugin designer uitools
+QT      += widgets concurrent uiplugin designer uitools
 CONFIG  += plugin c++11
 DEFINES += QOFFICE_BUILD_SHARED
 
+# Compiles in the OfficeProfiler probes: qmake CONFIG+=qoffice_profiler
+qoffice_profiler {
+    DEFINES += QOFFICE_ENABLE_PROFILER
+}
+
 ###########################################################
 # WINDOWS SETTINGS
 #
@@ -50,11 +55,20 @@ INCLUDEPATH += include \
 # RESOURCES & MISCELLANEOUS
 #
 ###########################################################
-RESOURCES += resources/qoffice_plugins.qrc \
-             resources/qoffice_images.qrc \
-             resources/qoffice_editors.qrc \
-             resources/qoffice_fonts.qrc \
-             resources/qoffice_stylesheets.qrc
+RESOURCES += resources/qoffice_plugins.qrc
+
+# Emits all but the designer plugin resources into an external bundle named
+# qoffice.rcc next to the library: qmake CONFIG+=qoffice_external_resources
+BUNDLED_RESOURCES = $${PWD}/resources/qoffice_images.qrc \
+                    $${PWD}/resources/qoffice_editors.qrc \
+                    $${PWD}/resources/qoffice_fonts.qrc \
+                    $${PWD}/resources/qoffice_stylesheets.qrc
+
+qoffice_external_resources {
+    DEFINES += QOFFICE_EXTERNAL_RESOURCES
+} else {
+    RESOURCES += $${BUNDLED_RESOURCES}
+}
 
 ###########################################################
 # HEADER FILES
@@ -66,8 +80,10 @@ HEADERS += include/QOffice/Config.hpp \
            include/QOffice/Design/OfficePalette.hpp \
            include/QOffice/Design/OfficeImage.hpp \
            include/QOffice/Design/OfficeFont.hpp \
+           include/QOffice/Design/OfficeProfiler.hpp \
+           include/QOffice/Design/OfficePerformance.hpp \
+           include/QOffice/Design/OfficeAnimationClock.hpp \
            include/QOffice/Widgets/Dialogs/OfficeWindow.hpp \
-           include/QOffice/Widgets/Dialogs/OfficeWindowResizeArea.hpp \
            include/QOffice/Design/Office.hpp \
            include/QOffice/Widgets/OfficeWindowMenu.hpp \
            include/QOffice/Widgets/OfficeWindowMenuItem.hpp \
@@ -77,8 +93,15 @@ HEADERS += include/QOffice/Config.hpp \
            include/QOffice/Widgets/OfficeMenuPanel.hpp \
            include/QOffice/Widgets/OfficeMenuItem.hpp \
            include/QOffice/Widgets/Dialogs/OfficeWindowTitlebar.hpp \
+           include/QOffice/Widgets/Dialogs/OfficeWindowDebugOverlay.hpp \
            include/QOffice/Widgets/OfficeMenuPinButton.hpp \
+           include/QOffice/Widgets/OfficeMenuKeyTips.hpp \
+           include/QOffice/Widgets/OfficeMenuCommandIndex.hpp \
            include/QOffice/Widgets/OfficeMenuPanelBar.hpp \
+           include/QOffice/Widgets/OfficeMenuPanelSnapshot.hpp \
+           include/QOffice/Widgets/OfficeMenuPanelLayout.hpp \
+           include/QOffice/Widgets/OfficeMenuPanelButton.hpp \
+           include/QOffice/Widgets/OfficeMenuLightItem.hpp \
            include/QOffice/Widgets/OfficeMenuEvent.hpp \
            include/QOffice/Widgets/OfficeTextbox.hpp \
            include/QOffice/Widgets/MenuItems/OfficeMenuTextboxItem.hpp \
@@ -93,7 +116,9 @@ SOURCES += src/Widgets/OfficeWidget.cpp \
            src/Design/OfficePalette.cpp \
            src/Design/OfficeImage.cpp \
            src/Design/OfficeFont.cpp \
-           src/Widgets/Dialogs/OfficeWindowResizeArea.cpp \
+           src/Design/OfficeProfiler.cpp \
+           src/Design/OfficePerformance.cpp \
+           src/Design/OfficeAnimationClock.cpp \
            src/Widgets/Dialogs/OfficeWindow.cpp \
            src/Widgets/OfficeWindowMenu.cpp \
            src/Widgets/OfficeWindowMenuItem.cpp \
@@ -103,8 +128,15 @@ SOURCES += src/Widgets/OfficeWidget.cpp \
            src/Widgets/OfficeMenuPanel.cpp \
            src/Widgets/OfficeMenuItem.cpp \
            src/Widgets/Dialogs/OfficeWindowTitlebar.cpp \
+           src/Widgets/Dialogs/OfficeWindowDebugOverlay.cpp \
            src/Widgets/OfficeMenuPinButton.cpp \
+           src/Widgets/OfficeMenuKeyTips.cpp \
+           src/Widgets/OfficeMenuCommandIndex.cpp \
            src/Widgets/OfficeMenuPanelBar.cpp \
+           src/Widgets/OfficeMenuPanelSnapshot.cpp \
+           src/Widgets/OfficeMenuPanelLayout.cpp \
+           src/Widgets/OfficeMenuPanelButton.cpp \
+           src/Widgets/OfficeMenuLightItem.cpp \
            src/Widgets/OfficeMenuEvent.cpp \
            src/Design/Office.cpp \
            src/Widgets/OfficeTextbox.cpp \
@@ -123,3 +155,13 @@ OBJECTS_DIR = $${DESTDIR}/obj
 MOC_DIR     = $${OBJECTS_DIR}
 RCC_DIR     = $${OBJECTS_DIR}
 UI_DIR      = $${OBJECTS_DIR}
+
+qoffice_external_resources {
+    qoffice_rcc.target   = $${DESTDIR}/qoffice.rcc
+    qoffice_rcc.depends  = $${BUNDLED_RESOURCES}
+    qoffice_rcc.commands = $$shell_path($$[QT_HOST_BINS]/rcc) -binary \
+                           $${BUNDLED_RESOURCES} -o $${qoffice_rcc.target}
+
+    QMAKE_EXTRA_TARGETS += qoffice_rcc
+    POST_TARGETDEPS     += $${qoffice_rcc.target}
+}
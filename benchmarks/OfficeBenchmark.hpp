@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#ifndef QOFFICE_BENCHMARKS_OFFICEBENCHMARK_HPP
+#define QOFFICE_BENCHMARKS_OFFICEBENCHMARK_HPP
+
+#include <QApplication>
+#include <QFileInfo>
+#include <QtTest>
+
+namespace OfficeBenchmark
+{
+    ////////////////////////////////////////////////////////////////////////////
+    /// Runs the benchmarks of the test class \p T headless and reproducibly.
+    /// Unless the environment says otherwise, the offscreen platform is used.
+    /// Unless the arguments specify an output, the results are written to
+    /// <name>.csv in the working directory and the plain-text report goes to
+    /// stdout.
+    ///
+    /// \tparam T The QtTest class holding the benchmarks.
+    /// \param[in] argc The argument count passed to main.
+    /// \param[in] argv The arguments passed to main.
+    /// \return The exit code of QTest::qExec.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    int exec(int argc, char** argv)
+    {
+        if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+        {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+
+        QApplication app(argc, argv);
+        QStringList args = app.arguments();
+
+        if (!args.contains("-o"))
+        {
+            const QString name = QFileInfo(args.first()).baseName();
+            args << "-o" << name + ".csv,csv" << "-o" << "-,txt";
+        }
+
+        T object;
+        return QTest::qExec(&object, args);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replaces QTEST_MAIN for QOffice benchmarks.
+///
+/// \sa OfficeBenchmark::exec
+///
+////////////////////////////////////////////////////////////////////////////////
+#define OFFICE_BENCHMARK_MAIN(type) \
+    int main(int argc, char** argv) \
+    { \
+        return OfficeBenchmark::exec<type>(argc, argv); \
+    }
+
+#endif
@@ -0,0 +1,46 @@
+###########################################################
+#
+#   QOffice: The office framework for Qt
+#   Copyright (C) 2016-2018 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+# GENERAL SETTINGS
+#
+###########################################################
+TEMPLATE = app
+QT      += widgets concurrent testlib
+CONFIG  += c++11 console testcase
+CONFIG  -= app_bundle
+
+# Benchmarks measure optimized code only.
+CONFIG  -= debug
+CONFIG  += release
+
+###########################################################
+# INCLUDE SETTINGS
+#
+###########################################################
+INCLUDEPATH += $${PWD}/../include \
+               $${PWD}/../include/QOffice \
+               $${PWD}/../include/QOffice/Widgets \
+               $${PWD}
+
+HEADERS += $${PWD}/OfficeBenchmark.hpp
+
+###########################################################
+# OUTPUT SETTINGS
+#
+###########################################################
+include($${PWD}/../platforms/platforms.pri)
+
+LIBS        += -L$${PWD}/../bin/$${kgl_path} -lQOffice
+DESTDIR      = $${PWD}/../bin/$${kgl_path}/benchmarks
+OBJECTS_DIR  = $${DESTDIR}/obj/$${TARGET}
+MOC_DIR      = $${OBJECTS_DIR}
+
+unix:!macx {
+    QMAKE_RPATHDIR += $${PWD}/../bin/$${kgl_path}
+}
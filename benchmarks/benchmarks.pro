@@ -0,0 +1,26 @@
+###########################################################
+#
+#   QOffice: The office framework for Qt
+#   Copyright (C) 2016-2018 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+
+###########################################################
+# GENERAL SETTINGS
+#
+# Build QOffice.pro first; every benchmark links against
+# the library in bin/. Run a benchmark without arguments
+# to write <name>.csv next to the plain-text report.
+#
+###########################################################
+TEMPLATE = subdirs
+SUBDIRS += image \
+           font \
+           menu \
+           tooltip \
+           window \
+           windowstate \
+           paintcount \
+           lineedit \
+           panellayout
@@ -0,0 +1,11 @@
+###########################################################
+#
+#   QOffice: The office framework for Qt
+#   Copyright (C) 2016-2018 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+TARGET   = bench_font
+SOURCES += tst_bench_font.cpp
+
+include(../benchmarks.pri)
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficeFont.hpp>
+#include <OfficeBenchmark.hpp>
+
+class tst_bench_font : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void font_data();
+    void font();
+};
+
+void tst_bench_font::initTestCase()
+{
+    // The first lookup loads the font files; measure the cached path only.
+    OfficeFont::font(OfficeFont::Regular, OfficeFont::Medium);
+}
+
+void tst_bench_font::font_data()
+{
+    QTest::addColumn<int>("weight");
+    QTest::addColumn<float>("pointSize");
+
+    QTest::newRow("regular-medium")
+        << static_cast<int>(OfficeFont::Regular) << float(OfficeFont::Medium);
+    QTest::newRow("semibold-large")
+        << static_cast<int>(OfficeFont::Semibold) << float(OfficeFont::Large);
+    QTest::newRow("light-title")
+        << static_cast<int>(OfficeFont::Light) << float(OfficeFont::Title);
+}
+
+void tst_bench_font::font()
+{
+    QFETCH(int, weight);
+    QFETCH(float, pointSize);
+
+    const auto w = static_cast<OfficeFont::Weight>(weight);
+    OfficeFont::font(w, pointSize);
+
+    QBENCHMARK
+    {
+        const QFont& font = OfficeFont::font(w, pointSize);
+        QVERIFY(font.pointSizeF() > 0);
+    }
+}
+
+OFFICE_BENCHMARK_MAIN(tst_bench_font)
+#include "tst_bench_font.moc"
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficeImage.hpp>
+#include <OfficeBenchmark.hpp>
+
+class tst_bench_image : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void generateDropShadow_data();
+    void generateDropShadow();
+    void convertToGrayscale_data();
+    void convertToGrayscale();
+};
+
+void tst_bench_image::generateDropShadow_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<qreal>("ratio");
+
+    QTest::newRow("tooltip") << QSize(300, 80) << 1.0;
+    QTest::newRow("window") << QSize(1280, 720) << 1.0;
+    QTest::newRow("window@2x") << QSize(1280, 720) << 2.0;
+}
+
+void tst_bench_image::generateDropShadow()
+{
+    QFETCH(QSize, size);
+    QFETCH(qreal, ratio);
+
+    QBENCHMARK
+    {
+        const QImage shadow = OfficeImage::generateDropShadowImage(size, ratio);
+        QVERIFY(!shadow.isNull());
+    }
+}
+
+void tst_bench_image::convertToGrayscale_data()
+{
+    QTest::addColumn<int>("extent");
+
+    QTest::newRow("icon16") << 16;
+    QTest::newRow("icon32") << 32;
+    QTest::newRow("image512") << 512;
+}
+
+void tst_bench_image::convertToGrayscale()
+{
+    QFETCH(int, extent);
+
+    // A deterministic gradient keeps every run comparable.
+    QImage original(extent, extent, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < extent; ++y)
+    {
+        for (int x = 0; x < extent; ++x)
+        {
+            original.setPixel(x, y, qRgba(x * 255 / extent, y * 255 / extent,
+                128, 255));
+        }
+    }
+
+    QBENCHMARK
+    {
+        const QImage gray = OfficeImage::convertToGrayscale(original);
+        QVERIFY(!gray.isNull());
+    }
+}
+
+OFFICE_BENCHMARK_MAIN(tst_bench_image)
+#include "tst_bench_image.moc"
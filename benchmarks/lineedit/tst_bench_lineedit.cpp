@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Widgets/OfficeLineEdit.hpp>
+#include <OfficeBenchmark.hpp>
+
+class tst_bench_lineedit : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void validate_data();
+    void validate();
+};
+
+void tst_bench_lineedit::validate_data()
+{
+    QTest::addColumn<int>("format");
+    QTest::addColumn<QString>("input");
+
+    // Every input mixes accepted and rejected characters.
+    const QString mixed("12.5e3-0x1Fz9 ");
+    QTest::newRow("default")
+        << static_cast<int>(OfficeLineEdit::Default) << mixed.repeated(8);
+    QTest::newRow("ascii")
+        << static_cast<int>(OfficeLineEdit::AsciiOnly) << mixed.repeated(8);
+    QTest::newRow("integer")
+        << static_cast<int>(OfficeLineEdit::IntegerOnly) << mixed.repeated(8);
+    QTest::newRow("float")
+        << static_cast<int>(OfficeLineEdit::FloatOnly) << mixed.repeated(8);
+    QTest::newRow("hex")
+        << static_cast<int>(OfficeLineEdit::HexOnly) << mixed.repeated(8);
+}
+
+void tst_bench_lineedit::validate()
+{
+    QFETCH(int, format);
+    QFETCH(QString, input);
+
+    OfficeLineEdit edit;
+    edit.setFormat(static_cast<OfficeLineEdit::Format>(format));
+
+    QBENCHMARK
+    {
+        QTest::keyClicks(&edit, input);
+        edit.clear();
+    }
+}
+
+OFFICE_BENCHMARK_MAIN(tst_bench_lineedit)
+#include "tst_bench_lineedit.moc"
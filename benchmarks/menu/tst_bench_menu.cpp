@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Widgets/MenuItems/OfficeMenuTextboxItem.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuHeader.hpp>
+#include <QOffice/Widgets/OfficeMenuLightItem.hpp>
+#include <QOffice/Widgets/OfficeMenuPanel.hpp>
+#include <OfficeBenchmark.hpp>
+#include <QPushButton>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_headerCount = 10)
+OffAnonymous(QOFFICE_CONSTEXPR int c_panelCount = 10)
+OffAnonymous(QOFFICE_CONSTEXPR int c_itemCount = 10)
+OffAnonymous(QOFFICE_CONSTEXPR int c_rowCount = 3)
+OffAnonymous(QOFFICE_CONSTEXPR int c_commandCount = 100)
+
+namespace
+{
+    // The cheapest widget item there is, searched by its button text.
+    class CommandItem : public QPushButton, public OfficeMenuItem
+    {
+    public:
+
+        CommandItem(const QString& text)
+            : QPushButton(text)
+        {
+        }
+
+        virtual QWidget* widget() override
+        {
+            return this;
+        }
+    };
+
+    // 10 headers with 10 panels of 10 items each.
+    void populate(OfficeMenu* menu, bool widgets)
+    {
+        for (int h = 0; h < c_headerCount; ++h)
+        {
+            auto* header = menu->appendHeader(h, QString("Header %1").arg(h));
+            for (int p = 0; p < c_panelCount; ++p)
+            {
+                auto* panel = header->appendPanel(
+                    p, QString("Panel %1").arg(p));
+                for (int i = 0; i < c_itemCount; ++i)
+                {
+                    const int row = i % c_rowCount;
+                    const int column = i / c_rowCount;
+
+                    if (widgets)
+                    {
+                        panel->insertItem(i, new OfficeMenuTextboxItem,
+                            row, column);
+                    }
+                    else
+                    {
+                        const OfficeMenuLightItem item(
+                            QString("Item %1").arg(i));
+                        panel->insertLightItem(i, item, row, column);
+                    }
+                }
+            }
+        }
+    }
+
+    const char* const g_commandWords[] =
+    {
+        "Copy", "Cut", "Paste", "Comment", "Compare", "Connect", "Color",
+        "Format", "Find", "Replace", "Insert", "Delete"
+    };
+}
+
+class tst_bench_menu : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void buildRibbon_data();
+    void buildRibbon();
+    void hoverRibbon_data();
+    void hoverRibbon();
+    void findCommands_data();
+    void findCommands();
+};
+
+void tst_bench_menu::buildRibbon_data()
+{
+    QTest::addColumn<bool>("widgets");
+
+    QTest::newRow("1000 light items") << false;
+    QTest::newRow("1000 textbox items") << true;
+}
+
+void tst_bench_menu::buildRibbon()
+{
+    QFETCH(bool, widgets);
+
+    QBENCHMARK
+    {
+        QWidget host;
+        host.resize(1280, 720);
+
+        OfficeMenu* menu = new OfficeMenu(&host);
+        menu->resize(1280, menu->sizeHint().height());
+
+        populate(menu, widgets);
+
+        // Expanding lays out the panels and computes their tiers.
+        menu->expand(menu->headerById(0));
+        QVERIFY(menu->headerById(c_headerCount - 1) != nullptr);
+    }
+}
+
+void tst_bench_menu::hoverRibbon_data()
+{
+    buildRibbon_data();
+}
+
+void tst_bench_menu::hoverRibbon()
+{
+    QFETCH(bool, widgets);
+
+    QWidget host;
+    host.resize(1280, 720);
+
+    OfficeMenu* menu = new OfficeMenu(&host);
+    menu->resize(1280, menu->sizeHint().height());
+    populate(menu, widgets);
+
+    host.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&host));
+
+    // The live panel bar is shown once the expand animation has finished.
+    QWidget* bar = menu->headerById(0)->panelById(0)->parentWidget();
+    menu->expand(menu->headerById(0));
+    QTRY_VERIFY(bar->isVisible());
+
+    // Sweeps the mouse over every row of items of the expanded panel bar.
+    QVector<QPoint> sweep;
+    const QPoint origin = bar->mapTo(&host, QPoint());
+    for (int row = 0; row < c_rowCount; ++row)
+    {
+        const int y = origin.y() + bar->height() * (2 * row + 1) / 6;
+        for (int x = 0; x < bar->width(); x += 8)
+        {
+            sweep.append(QPoint(origin.x() + x, y));
+        }
+    }
+
+    QBENCHMARK
+    {
+        for (const QPoint& pos : sweep)
+        {
+            QTest::mouseMove(&host, pos);
+            QCoreApplication::processEvents();
+        }
+    }
+}
+
+void tst_bench_menu::findCommands_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<int>("expected");
+
+    // Every keystroke of "comment 42" over 10000 commands, each of which should
+    // be answered in less than a millisecond. Numbers match the command, its ID
+    // and its panel, thus "comment 4" also finds "Comment 1047" with ID 47.
+    QTest::newRow("c") << QString("c") << 5001;
+    QTest::newRow("co") << QString("co") << 4167;
+    QTest::newRow("com") << QString("com") << 1667;
+    QTest::newRow("comm") << QString("comm") << 834;
+    QTest::newRow("comme") << QString("comme") << 834;
+    QTest::newRow("commen") << QString("commen") << 834;
+    QTest::newRow("comment") << QString("comment") << 834;
+    QTest::newRow("comment 4") << QString("comment 4") << 211;
+    QTest::newRow("comment 42") << QString("comment 42") << 10;
+}
+
+void tst_bench_menu::findCommands()
+{
+    QFETCH(QString, query);
+    QFETCH(int, expected);
+
+    QWidget host;
+    host.resize(1280, 720);
+
+    OfficeMenu* menu = new OfficeMenu(&host);
+    menu->resize(1280, menu->sizeHint().height());
+
+    // 10 headers with 10 panels of 100 commands each.
+    int command = 0;
+    for (int h = 0; h < c_headerCount; ++h)
+    {
+        auto* header = menu->appendHeader(h, QString("Header %1").arg(h));
+        for (int p = 0; p < c_panelCount; ++p)
+        {
+            auto* panel = header->appendPanel(p, QString("Panel %1").arg(p));
+            for (int i = 0; i < c_commandCount; ++i, ++command)
+            {
+                const int words = sizeof(g_commandWords) / sizeof(char*);
+                const QString text = QString("%1 %2")
+                    .arg(g_commandWords[command % words])
+                    .arg(command);
+
+                panel->insertItem(i, new CommandItem(text),
+                    i % c_rowCount, i / c_rowCount);
+            }
+        }
+    }
+
+    QList<OfficeMenuItem*> result;
+    QBENCHMARK
+    {
+        // The empty query drops the matches of the previous keystroke, thus
+        // every query is measured without being narrowed from the last one.
+        menu->findCommands(QString());
+        result = menu->findCommands(query);
+    }
+
+    QCOMPARE(result.size(), expected);
+}
+
+OFFICE_BENCHMARK_MAIN(tst_bench_menu)
+#include "tst_bench_menu.moc"
@@ -0,0 +1,11 @@
+###########################################################
+#
+#   QOffice: The office framework for Qt
+#   Copyright (C) 2016-2018 Nicolas Kogler
+#   License: Lesser General Public License 3.0
+#
+###########################################################
+TARGET   = tst_paintcount
+SOURCES += tst_paintcount.cpp
+
+include(../benchmarks.pri)
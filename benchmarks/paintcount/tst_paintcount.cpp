@@ -0,0 +1,309 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuHeader.hpp>
+#include <QOffice/Widgets/OfficeMenuPanel.hpp>
+#include <QOffice/Widgets/OfficeWindowMenu.hpp>
+#include <OfficeBenchmark.hpp>
+
+namespace
+{
+    // Counts the paint events of a single widget and unites their regions.
+    class PaintCounter : public QObject
+    {
+    public:
+
+        PaintCounter(QWidget* widget)
+            : QObject(widget)
+            , m_count(0)
+        {
+            widget->installEventFilter(this);
+        }
+
+        int count() const
+        {
+            return m_count;
+        }
+
+        const QRegion& region() const
+        {
+            return m_region;
+        }
+
+        void reset()
+        {
+            m_count = 0;
+            m_region = QRegion();
+        }
+
+    protected:
+
+        virtual bool eventFilter(QObject*, QEvent* event) override
+        {
+            if (event->type() == QEvent::Paint)
+            {
+                m_count++;
+                m_region += static_cast<QPaintEvent*>(event)->region();
+            }
+
+            return false;
+        }
+
+    private:
+
+        int     m_count;
+        QRegion m_region;
+    };
+
+    // Sends the given event and delivers all repaints it caused.
+    void send(QWidget* widget, QEvent::Type type)
+    {
+        QEvent event(type);
+        QApplication::sendEvent(widget, &event);
+        QCoreApplication::processEvents();
+    }
+
+    void press(QWidget* widget, const QPoint& pos)
+    {
+        QTest::mousePress(widget, Qt::LeftButton, Qt::NoModifier, pos);
+        QCoreApplication::processEvents();
+    }
+
+    void release(QWidget* widget, const QPoint& pos)
+    {
+        QTest::mouseRelease(widget, Qt::LeftButton, Qt::NoModifier, pos);
+        QCoreApplication::processEvents();
+    }
+
+    QWidget* windowItem(OfficeWindowMenu* menu)
+    {
+        for (auto* child : menu->findChildren<QWidget*>())
+        {
+            if (child->inherits("priv::WindowItem"))
+            {
+                return child;
+            }
+        }
+
+        return nullptr;
+    }
+}
+
+class tst_paintcount : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void menuHeader();
+    void pinButton();
+    void windowLabelItem();
+    void windowQuickItem();
+
+private:
+
+    void showMenu(QWidget& host, OfficeMenu*& menu);
+    void showWindow(OfficeWindow& window);
+};
+
+void tst_paintcount::initTestCase()
+{
+    // Flat hover states would not repaint anything at all.
+    OfficePerformance::setProfile(OfficePerformance::DefaultProfile);
+}
+
+void tst_paintcount::showMenu(QWidget& host, OfficeMenu*& menu)
+{
+    host.resize(1280, 720);
+
+    menu = new OfficeMenu(&host);
+    menu->resize(1280, menu->sizeHint().height());
+    menu->appendHeader(0, "Home")->appendPanel(0, "Clipboard");
+    menu->appendHeader(1, "Insert");
+
+    host.show();
+    QVERIFY(QTest::qWaitForWindowActive(&host));
+
+    // The first header is selected, thus presses that the pin button passes on
+    // to its header do not expand the menu in the middle of a measurement.
+    QWidget* bar = menu->headerById(0)->panelById(0)->parentWidget();
+    menu->expand(menu->headerById(0));
+    QTRY_VERIFY(bar->isVisible());
+    QCoreApplication::processEvents();
+}
+
+void tst_paintcount::showWindow(OfficeWindow& window)
+{
+    // Without a shadow, no shadow is generated in the background, which would
+    // repaint the entire window once it is done.
+    window.setFlags(OfficeWindow::NoShadow);
+    window.labelMenu()->addLabelItem(0, "Help", "Shows the help.");
+    window.quickMenu()->addQuickItem(0, QPixmap(16, 16), "Saves the file.");
+    window.resize(800, 600);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowActive(&window));
+    QCoreApplication::processEvents();
+}
+
+void tst_paintcount::menuHeader()
+{
+    QWidget host;
+    OfficeMenu* menu = nullptr;
+    showMenu(host, menu);
+    if (QTest::currentTestFailed())
+    {
+        return;
+    }
+
+    OfficeMenuHeader* header = menu->headerById(1);
+    PaintCounter counter(header);
+
+    // Hovering repaints the header once, but only if its look changes.
+    send(header, QEvent::Enter);
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(header->rect()));
+
+    counter.reset();
+    send(header, QEvent::Enter);
+    QCOMPARE(counter.count(), 0);
+
+    send(header, QEvent::Leave);
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(header->rect()));
+
+    // The selected header looks the same, whether it is hovered or not.
+    OfficeMenuHeader* selected = menu->headerById(0);
+    PaintCounter selectedCounter(selected);
+    send(selected, QEvent::Enter);
+    send(selected, QEvent::Leave);
+    QCOMPARE(selectedCounter.count(), 0);
+}
+
+void tst_paintcount::pinButton()
+{
+    QWidget host;
+    OfficeMenu* menu = nullptr;
+    showMenu(host, menu);
+    if (QTest::currentTestFailed())
+    {
+        return;
+    }
+
+    QWidget* button = menu->headerById(0)->findChild<QWidget*>(
+        QString(), Qt::FindDirectChildrenOnly);
+    QVERIFY(button != nullptr);
+
+    PaintCounter counter(button);
+    const QPoint outside(-1, -1);
+
+    send(button, QEvent::Enter);
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(button->rect()));
+
+    counter.reset();
+    press(button, button->rect().center());
+    QCOMPARE(counter.count(), 1);
+
+    // While pressed, the hover state is not visible at all.
+    counter.reset();
+    send(button, QEvent::Leave);
+    QCOMPARE(counter.count(), 0);
+
+    // Releasing outside the button does not toggle the pinned state, thus
+    // only the pressed look is removed, and only once.
+    release(button, outside);
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(button->rect()));
+
+    counter.reset();
+    release(button, outside);
+    QCOMPARE(counter.count(), 0);
+}
+
+void tst_paintcount::windowLabelItem()
+{
+    OfficeWindow window;
+    showWindow(window);
+    if (QTest::currentTestFailed())
+    {
+        return;
+    }
+
+    QWidget* label = windowItem(window.labelMenu());
+    QVERIFY(label != nullptr);
+
+    // Hovered labels underline their text, which is all that is repainted.
+    const QRect text = label->fontMetrics()
+        .boundingRect(label->rect(), 0, "Help")
+        .intersected(label->rect());
+
+    PaintCounter counter(label);
+    send(label, QEvent::Enter);
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(text));
+
+    // Labels have no pressed look.
+    counter.reset();
+    press(label, label->rect().center());
+    release(label, label->rect().center());
+    QCOMPARE(counter.count(), 0);
+
+    send(label, QEvent::Leave);
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(text));
+}
+
+void tst_paintcount::windowQuickItem()
+{
+    OfficeWindow window;
+    showWindow(window);
+    if (QTest::currentTestFailed())
+    {
+        return;
+    }
+
+    QWidget* item = windowItem(window.quickMenu());
+    QVERIFY(item != nullptr);
+
+    PaintCounter counter(item);
+    send(item, QEvent::Enter);
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(item->rect()));
+
+    // Quick items look pressed, hence both the press and the release repaint.
+    counter.reset();
+    press(item, item->rect().center());
+    QCOMPARE(counter.count(), 1);
+
+    counter.reset();
+    release(item, item->rect().center());
+    QCOMPARE(counter.count(), 1);
+    QCOMPARE(counter.region(), QRegion(item->rect()));
+}
+
+OFFICE_BENCHMARK_MAIN(tst_paintcount)
+#include "tst_paintcount.moc"
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Widgets/MenuItems/OfficeMenuTextboxItem.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuHeader.hpp>
+#include <QOffice/Widgets/OfficeMenuLightItem.hpp>
+#include <QOffice/Widgets/OfficeMenuPanel.hpp>
+#include <OfficeBenchmark.hpp>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_rowCount = 3)
+OffAnonymous(QOFFICE_CONSTEXPR int c_widgetEvery = 10)
+
+class tst_bench_panellayout : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void relayout_data();
+    void relayout();
+};
+
+void tst_bench_panellayout::relayout_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("widgets");
+
+    for (int count : { 10, 50, 100, 250, 500 })
+    {
+        QTest::newRow(qPrintable(QString("%1 light").arg(count)))
+            << count << false;
+        QTest::newRow(qPrintable(QString("%1 mixed").arg(count)))
+            << count << true;
+    }
+}
+
+void tst_bench_panellayout::relayout()
+{
+    QFETCH(int, count);
+    QFETCH(bool, widgets);
+
+    QWidget host;
+    OfficeMenu* menu = new OfficeMenu(&host);
+    OfficeMenuHeader* header = menu->appendHeader(0, "Home");
+    OfficeMenuPanel* panel = header->appendPanel(0, "Edit");
+
+    // The mixed rows replace every tenth light item by a textbox.
+    for (int i = 0; i < count; ++i)
+    {
+        const int row = i % c_rowCount;
+        const int column = i / c_rowCount;
+
+        if (widgets && i % c_widgetEvery == 0)
+        {
+            panel->insertItem(i, new OfficeMenuTextboxItem, row, column);
+        }
+        else
+        {
+            const OfficeMenuLightItem item(QString("Item %1").arg(i));
+            panel->insertLightItem(i, item, row, column);
+        }
+    }
+
+    QLayout* layout = panel->layout();
+    QVERIFY(layout != nullptr);
+
+    QBENCHMARK
+    {
+        layout->invalidate();
+        layout->setGeometry(QRect(QPoint(), layout->sizeHint()));
+    }
+
+    // Light items are spacers; they must still be given their cells.
+    for (int i = 0; i < layout->count(); ++i)
+    {
+        QVERIFY(!layout->itemAt(i)->geometry().isEmpty());
+    }
+}
+
+OFFICE_BENCHMARK_MAIN(tst_bench_panellayout)
+#include "tst_bench_panellayout.moc"
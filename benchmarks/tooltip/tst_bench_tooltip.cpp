@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Widgets/OfficeTooltip.hpp>
+#include <OfficeBenchmark.hpp>
+
+class tst_bench_tooltip : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void showAndPaint_data();
+    void showAndPaint();
+};
+
+void tst_bench_tooltip::showAndPaint_data()
+{
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("short") << QString("Copies the selection.");
+    QTest::newRow("long") << QString("Copies the selection to the clipboard, "
+        "so that it can be pasted somewhere else. ").repeated(4);
+}
+
+void tst_bench_tooltip::showAndPaint()
+{
+    QFETCH(QString, text);
+
+    OfficeTooltip tooltip;
+    tooltip.setTitle("Copy (Ctrl+C)");
+    tooltip.setWaitPeriod(0);
+    int round = 0;
+
+    QBENCHMARK
+    {
+        // Changing the text forces the layout and the drop shadow to be
+        // recomputed, as when the tooltip is shown for another item.
+        tooltip.setText(text + QString::number(++round % 2));
+        tooltip.show();
+        const QPixmap frame = tooltip.grab();
+        tooltip.hide();
+        QVERIFY(!frame.isNull());
+    }
+}
+
+OFFICE_BENCHMARK_MAIN(tst_bench_tooltip)
+#include "tst_bench_tooltip.moc"
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
+#include <OfficeBenchmark.hpp>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPixmapCache>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_stormLength = 50)
+OffAnonymous(QOFFICE_CONSTEXPR int c_sessionLength = 20)
+
+namespace
+{
+    // Opens 20 windows with a ribbon each, whose pin button and tooltip load
+    // all resource images of QOffice.
+    QList<OfficeWindow*> createSession()
+    {
+        QList<OfficeWindow*> session;
+        for (int i = 0; i < c_sessionLength; ++i)
+        {
+            OfficeWindow* window = new OfficeWindow;
+            OfficeMenu* menu = new OfficeMenu(window);
+            menu->appendHeader(0, "Home");
+
+            window->resize(800, 600);
+            window->show();
+            session.append(window);
+        }
+
+        QCoreApplication::processEvents();
+        return session;
+    }
+}
+
+class tst_bench_window : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void resizeStorm_data();
+    void resizeStorm();
+    void openSession();
+    void decodeCount();
+};
+
+void tst_bench_window::resizeStorm_data()
+{
+    QTest::addColumn<int>("flags");
+    QTest::addColumn<QString>("title");
+
+    // Document paths are elided anew on every resize, since they never fit.
+    const QString path = QString("C:/Users/Public/Documents/Projects/%1"
+        "Quarterly Reports/2018/Drafts/Quarterly Report - Final (3).docx")
+        .arg(QString("Department of Very Long Folder Names/").repeated(4));
+
+    QTest::newRow("shadow")
+        << static_cast<int>(OfficeWindow::NoFlag) << QString("Window");
+    QTest::newRow("no shadow")
+        << static_cast<int>(OfficeWindow::NoShadow) << QString("Window");
+    QTest::newRow("document path")
+        << static_cast<int>(OfficeWindow::NoFlag) << path;
+}
+
+void tst_bench_window::resizeStorm()
+{
+    QFETCH(int, flags);
+    QFETCH(QString, title);
+
+    OfficeWindow window;
+    window.setFlags(static_cast<OfficeWindow::Flags>(flags));
+    window.setWindowTitle(title);
+    window.resize(800, 600);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QBENCHMARK
+    {
+        // Mimics dragging the bottom-right corner: one resize and one event
+        // loop iteration per mouse move.
+        for (int i = 0; i < c_stormLength; ++i)
+        {
+            window.resize(800 + i * 8, 600 + i * 4);
+            QCoreApplication::processEvents();
+        }
+    }
+}
+
+void tst_bench_window::openSession()
+{
+    QBENCHMARK
+    {
+        // Every session starts as cold as the first one of the application.
+        QPixmapCache::clear();
+        qDeleteAll(createSession());
+    }
+}
+
+void tst_bench_window::decodeCount()
+{
+    QPixmapCache::clear();
+    OfficeProfiler::clear();
+    OfficeProfiler::setEnabled(true);
+
+    const QList<OfficeWindow*> session = createSession();
+
+    OfficeProfiler::setEnabled(false);
+    qDeleteAll(session);
+
+    // Every decode records the counter once.
+    const QJsonDocument trace =
+        QJsonDocument::fromJson(OfficeProfiler::exportChromeTrace());
+
+    int decodes = 0;
+    for (const auto& event : trace.object().value("traceEvents").toArray())
+    {
+        const QString name = event.toObject().value("name").toString();
+        if (name == QLatin1String("OfficeImage::decodeCount"))
+        {
+            decodes++;
+        }
+    }
+
+    if (decodes == 0)
+    {
+        QSKIP("QOffice has been built without CONFIG+=qoffice_profiler.");
+    }
+
+    // Both pin images and the help icon, regardless of the session length.
+    qInfo("%d windows decoded %d images", c_sessionLength, decodes);
+    QCOMPARE(decodes, 3);
+}
+
+OFFICE_BENCHMARK_MAIN(tst_bench_window)
+#include "tst_bench_window.moc"
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Benchmark module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
+#include <OfficeBenchmark.hpp>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_resizeBorder = 10)
+OffAnonymous(QOFFICE_CONSTEXPR int c_resizeGrip = 4)
+OffAnonymous(QOFFICE_CONSTEXPR int c_titleY = 20)
+
+namespace
+{
+    // QTest::mouseMove merely moves the cursor of the offscreen platform, thus
+    // the mouse events are sent to the widget directly.
+    void sendMouse(QWidget* widget, QEvent::Type type, const QPoint& pos)
+    {
+        const Qt::MouseButton button = (type == QEvent::MouseMove)
+            ? Qt::NoButton
+            : Qt::LeftButton;
+        const Qt::MouseButtons buttons = (type == QEvent::MouseButtonRelease)
+            ? Qt::NoButton
+            : Qt::LeftButton;
+
+        QMouseEvent event(type, pos, widget->mapToGlobal(pos), button, buttons,
+            Qt::NoModifier);
+        QApplication::sendEvent(widget, &event);
+    }
+
+    void sendHover(QWidget* widget, const QPoint& pos)
+    {
+        QHoverEvent event(QEvent::HoverMove, pos, pos);
+        QApplication::sendEvent(widget, &event);
+    }
+}
+
+class tst_windowstate : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void resizeZones_data();
+    void resizeZones();
+    void resize_data();
+    void resize();
+    void move_data();
+    void move();
+};
+
+void tst_windowstate::resizeZones_data()
+{
+    QTest::addColumn<int>("flags");
+    QTest::addColumn<int>("border");
+
+    QTest::newRow("shadow")
+        << static_cast<int>(OfficeWindow::NoFlag) << c_resizeBorder;
+    QTest::newRow("no shadow")
+        << static_cast<int>(OfficeWindow::NoShadow) << c_resizeGrip;
+    QTest::newRow("no resize")
+        << static_cast<int>(OfficeWindow::NoResize) << 0;
+}
+
+void tst_windowstate::resizeZones()
+{
+    QFETCH(int, flags);
+    QFETCH(int, border);
+
+    OfficeWindow window;
+    window.setFlags(static_cast<OfficeWindow::Flags>(flags));
+    window.resize(800, 600);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    struct Probe
+    {
+        QPoint          pos;
+        Qt::CursorShape shape;
+    };
+
+    // Every zone is probed on both sides of its border.
+    const int w = window.width();
+    const int h = window.height();
+    const Probe probes[] =
+    {
+        { QPoint(border - 1, h / 2), Qt::SizeHorCursor },
+        { QPoint(border, h / 2), Qt::ArrowCursor },
+        { QPoint(w - border, h / 2), Qt::SizeHorCursor },
+        { QPoint(w - border - 1, h / 2), Qt::ArrowCursor },
+        { QPoint(w / 2, border - 1), Qt::SizeVerCursor },
+        { QPoint(w / 2, h - border), Qt::SizeVerCursor },
+        { QPoint(0, 0), Qt::SizeFDiagCursor },
+        { QPoint(w - 1, 0), Qt::SizeBDiagCursor },
+        { QPoint(0, h - 1), Qt::SizeBDiagCursor },
+        { QPoint(w - 1, h - 1), Qt::SizeFDiagCursor },
+        { QPoint(w / 2, h / 2), Qt::ArrowCursor }
+    };
+
+    for (const Probe& probe : probes)
+    {
+        sendHover(&window, probe.pos);
+
+        const Qt::CursorShape expected = window.canResize()
+            ? probe.shape
+            : Qt::ArrowCursor;
+        QCOMPARE(window.cursor().shape(), expected);
+    }
+}
+
+void tst_windowstate::resize_data()
+{
+    QTest::addColumn<int>("flags");
+
+    // The offscreen platform cannot resize windows on its own, which leaves
+    // the system resize with the fallback of QOffice.
+    QTest::newRow("shadow")
+        << static_cast<int>(OfficeWindow::NoFlag);
+    QTest::newRow("no shadow")
+        << static_cast<int>(OfficeWindow::NoShadow);
+    QTest::newRow("system resize fallback")
+        << static_cast<int>(OfficeWindow::SystemMoveResize);
+}
+
+void tst_windowstate::resize()
+{
+    QFETCH(int, flags);
+
+    OfficeWindow window;
+    window.setFlags(static_cast<OfficeWindow::Flags>(flags));
+    window.resize(800, 600);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    const QPoint corner(window.width() - 2, window.height() - 2);
+    const QPoint center(window.width() / 2, window.height() / 2);
+    const QPoint delta(40, 30);
+    const QRect before = window.geometry();
+
+    // Grabbing the bottom-right corner starts resizing.
+    sendMouse(&window, QEvent::MouseButtonPress, corner);
+    QCOMPARE(window.cursor().shape(), Qt::SizeFDiagCursor);
+
+    const QPoint target = window.mapToGlobal(corner) + delta;
+    sendMouse(&window, QEvent::MouseMove, corner + delta);
+    QTRY_COMPARE(window.geometry().bottomRight(), target);
+    QCOMPARE(window.geometry().topLeft(), before.topLeft());
+
+    // The cursor keeps its shape while resizing, wherever the mouse is.
+    sendHover(&window, center);
+    QCOMPARE(window.cursor().shape(), Qt::SizeFDiagCursor);
+
+    // Once released, the mouse no longer resizes the window.
+    sendMouse(&window, QEvent::MouseButtonRelease, center);
+    QCOMPARE(window.cursor().shape(), Qt::ArrowCursor);
+
+    const QRect after = window.geometry();
+    sendMouse(&window, QEvent::MouseMove, corner + delta * 2);
+    QCoreApplication::processEvents();
+    QCOMPARE(window.geometry(), after);
+}
+
+void tst_windowstate::move_data()
+{
+    resize_data();
+}
+
+void tst_windowstate::move()
+{
+    QFETCH(int, flags);
+
+    OfficeWindow window;
+    window.setFlags(static_cast<OfficeWindow::Flags>(flags));
+    window.resize(800, 600);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QWidget* titlebar = window.childAt(window.width() / 2, c_titleY);
+    QVERIFY(titlebar != nullptr);
+
+    const QPoint grab = titlebar->mapFrom(&window,
+        QPoint(window.width() / 2, c_titleY));
+    const QPoint delta(50, 20);
+    const QRect before = window.geometry();
+
+    // Dragging the title moves the window by the distance of the mouse.
+    sendMouse(titlebar, QEvent::MouseButtonPress, grab);
+    sendMouse(titlebar, QEvent::MouseMove, grab + delta);
+    QTRY_COMPARE(window.geometry(), before.translated(delta));
+
+    // Once released, the mouse no longer moves the window.
+    sendMouse(titlebar, QEvent::MouseButtonRelease, grab + delta);
+    sendMouse(titlebar, QEvent::MouseMove, grab + delta * 2);
+    QCoreApplication::processEvents();
+    QCOMPARE(window.geometry(), before.translated(delta));
+}
+
+OFFICE_BENCHMARK_MAIN(tst_windowstate)
+#include "tst_windowstate.moc"
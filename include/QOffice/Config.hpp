@@ -141,6 +141,17 @@ inline QString QOfficeGetClass(const QString& func)
 
 #define OffCurrentClass QOfficeGetClass(OffCurrentFunc)
 
+// Instrumentation of hot paths, compiled out unless explicitly requested.
+#if defined(QOFFICE_ENABLE_PROFILER)
+    #define OffProfileJoinImpl(a,b) a##b
+    #define OffProfileJoin(a,b) OffProfileJoinImpl(a,b)
+    #define OffProfileScope(name) OfficeProfiler::Scope OffProfileJoin(offProfileScope, __LINE__)(name)
+    #define OffProfileCount(name,value) OfficeProfiler::count(name, value)
+#else
+    #define OffProfileScope(name)
+    #define OffProfileCount(name,value)
+#endif
+
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -195,6 +206,14 @@ inline QString QOfficeGetClass(const QString& func)
 /// \def OffCurrentClass
 /// Retrieves the beautified name of the current class.
 ///
+/// \def OffProfileScope
+/// Measures the enclosing scope under the given name, see OfficeProfiler.
+/// Expands to nothing unless QOFFICE_ENABLE_PROFILER is defined.
+///
+/// \def OffProfileCount
+/// Records a counter value under the given name, see OfficeProfiler.
+/// Expands to nothing unless QOFFICE_ENABLE_PROFILER is defined.
+///
 ////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +73,18 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     static QString loadStyleSheet(const QString& name);
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Makes sure that the QOffice resources are available. If QOffice has
+    /// been built with the resources in an external bundle, the bundle is
+    /// registered on the first call. Subsequent calls return immediately.
+    ///
+    /// \return True if the resources are available, false otherwise.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static bool ensureResources();
+
     ////////////////////////////////////////////////////////////////////////////
     /// Determines whether the given string is exclusively ASCII.
     ///
@@ -139,6 +151,11 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    static bool registerResources();
+
     Q_OBJECT
     Q_ENUM(Accent)
 };
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Design module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#ifndef QOFFICE_DESIGN_OFFICEANIMATIONCLOCK_HPP
+#define QOFFICE_DESIGN_OFFICEANIMATIONCLOCK_HPP
+
+#include <QOffice/Config.hpp>
+#include <QEasingCurve>
+#include <functional>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficeAnimationClock
+/// \brief Drives all QOffice animations from one clock.
+///
+////////////////////////////////////////////////////////////////////////////////
+class QOFFICE_DESIGN_API OfficeAnimationClock
+{
+public:
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Applies the eased progress of an animation, in [0, 1].
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    typedef std::function<void (qreal)> StepFunction;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Is called once an animation has run to its end.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    typedef std::function<void ()> FinishFunction;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Starts a new animation that belongs to the given \p owner. The \p step
+    /// function is applied immediately with the start progress and then once
+    /// per frame, until \p duration elapsed. An animation with a duration of
+    /// zero or less finishes before this function returns.
+    ///
+    /// The animation is cancelled silently as soon as its \p owner has been
+    /// destroyed, therefore the functions may safely capture the owner.
+    ///
+    /// \param[in] owner The object whose lifetime bounds the animation.
+    /// \param[in] duration The duration of the animation, in milliseconds.
+    /// \param[in] step The function that applies the progress.
+    /// \param[in] finished The function to call once the animation finished.
+    /// \param[in] curve The easing curve to apply to the progress.
+    /// \return The ID of the animation, zero if it has finished already.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static int start(
+        QObject* owner,
+        int duration,
+        const StepFunction& step,
+        const FinishFunction& finished = FinishFunction(),
+        const QEasingCurve& curve = QEasingCurve::Linear);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Stops the animation with the given \p id. Neither its step nor its
+    /// finish function is called anymore. Unknown IDs are ignored.
+    ///
+    /// \param[in] id The ID of the animation to stop.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void stop(int id);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether the animation with the given \p id is running.
+    ///
+    /// \param[in] id The ID of the animation.
+    /// \return True if running, false otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static bool isRunning(int id);
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficeAnimationClock
+/// \ingroup Design
+///
+/// The clock is a single QAbstractAnimation of infinite duration, so it ticks
+/// from the same unified animation timer as every other Qt animation, at most
+/// once per frame. All running QOffice animations advance in the same tick and
+/// share the same frame time, which makes their repaints land in a single
+/// frame. The clock stops as soon as no animation is running.
+///
+/// \code
+/// m_fade = OfficeAnimationClock::start(this, 200, [this](qreal progress)
+/// {
+///     m_opacity = progress;
+///     update();
+/// });
+/// \endcode
+///
+/// The clock must only be used from the GUI thread.
+///
+////////////////////////////////////////////////////////////////////////////////
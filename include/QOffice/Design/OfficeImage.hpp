@@ -41,6 +41,19 @@ class QOFFICE_DESIGN_API OfficeImage
 {
 public:
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \enum CaptionGlyph
+    /// \brief Defines the glyphs drawn onto the window caption buttons.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    enum CaptionGlyph
+    {
+        CloseGlyph,
+        MaximizeGlyph,
+        RestoreGlyph,
+        MinimizeGlyph
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     /// Converts an image to grayscale, while keeping the original image
     /// untouched. Do not call this function in QWidget::paintEvent, since it
@@ -65,14 +78,112 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     static QPixmap convertToGrayscale(const QPixmap& original);
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Loads the pixmap at the given \p path for the given device pixel ratio.
+    /// If a variant with an "@2x"-like suffix exists for the ratio, it is used
+    /// as is. Otherwise the pixmap is scaled to the device pixels once, so the
+    /// painter never has to scale it when drawing.
+    ///
+    /// The result is stored in the QPixmapCache under a "qoffice:" key, so
+    /// every widget of the process shares the same implicitly shared pixmap
+    /// and each file is decoded only once. This function must be called from
+    /// the GUI thread.
+    ///
+    /// \param[in] path The path of the pixmap, e.g. a resource path.
+    /// \param[in] ratio The device pixel ratio of the target screen.
+    /// \return The pixmap with the device pixel ratio set accordingly.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static QPixmap loadPixmap(const QString& path, qreal ratio);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the size of the given \p pixmap in device-independent pixels.
+    ///
+    /// \param[in] pixmap The pixmap to retrieve the size of.
+    /// \return The size in device-independent pixels.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static QSize logicalSize(const QPixmap& pixmap);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the size in device pixels that an image of the given \p size
+    /// has when being rendered for the given device pixel \p ratio.
+    ///
+    /// \param[in] size The size in device-independent pixels.
+    /// \param[in] ratio The device pixel ratio.
+    /// \return The size in device pixels.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static QSize deviceSize(const QSize& size, qreal ratio);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Renders the given caption \p glyph with the given \p color. The glyph
+    /// is drawn with vector strokes in device pixels, therefore it stays sharp
+    /// on every screen. The result is cached per size, ratio and color.
+    ///
+    /// \param[in] glyph The glyph to render.
+    /// \param[in] size The size of the glyph in device-independent pixels.
+    /// \param[in] ratio The device pixel ratio of the target screen.
+    /// \param[in] color The color of the glyph, alpha included.
+    /// \return The pixmap with the device pixel ratio set accordingly.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static QPixmap captionGlyph(
+        CaptionGlyph glyph,
+        const QSize& size,
+        qreal ratio,
+        const QColor& color
+        );
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the rectangle that centers the given \p pixmap within the
+    /// given \p area, based on the size in device-independent pixels.
+    ///
+    /// \param[in] pixmap The pixmap to center.
+    /// \param[in] area The area to center the pixmap in.
+    /// \return The target rectangle to draw the pixmap into.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static QRect centerRectangle(const QPixmap& pixmap, const QRect& area);
+
     ////////////////////////////////////////////////////////////////////////////
     /// Generates a drop shadow of the given \p size.
     ///
     /// \param[in] size The size of the drop shadow.
+    /// \param[in] ratio The device pixel ratio to render the shadow for.
     /// \return The pixmap containing the shadow.
     ///
     ////////////////////////////////////////////////////////////////////////////
-    static QPixmap generateDropShadow(const QSize& size);
+    static QPixmap generateDropShadow(const QSize& size, qreal ratio = 1.0);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Generates a drop shadow of the given \p size into a QImage. In contrast
+    /// to OfficeImage::generateDropShadow, this function does not touch any
+    /// QPixmap and can therefore be called from a worker thread.
+    ///
+    /// The image is rendered in device pixels and carries the given \p ratio,
+    /// therefore it is drawn onto a HiDPI screen without being upsampled.
+    ///
+    /// \param[in] size The size of the drop shadow.
+    /// \param[in] ratio The device pixel ratio to render the shadow for.
+    /// \return The image containing the shadow.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static QImage generateDropShadowImage(const QSize& size, qreal ratio = 1.0);
+
+private:
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    static QString cacheKey(const QString&);
+    static QPixmap decodePixmap(const QString&);
+    static QString variantPath(const QString&, int);
+    static void blurAlpha(QImage&, int);
 };
 
 #endif
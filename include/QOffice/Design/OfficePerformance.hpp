@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Design module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#ifndef QOFFICE_DESIGN_OFFICEPERFORMANCE_HPP
+#define QOFFICE_DESIGN_OFFICEPERFORMANCE_HPP
+
+#include <QOffice/Config.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficePerformance
+/// \brief Trades the visual effects of QOffice for less repainting.
+///
+////////////////////////////////////////////////////////////////////////////////
+class QOFFICE_DESIGN_API OfficePerformance
+{
+public:
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Defines all available performance profiles.
+    /// \enum Profile
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    enum Profile
+    {
+        DefaultProfile,
+        RemoteProfile
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the current performance profile. Unless a profile has been
+    /// selected through OfficePerformance::setProfile, the profile is read
+    /// from the QOFFICE_PERFORMANCE_PROFILE environment variable, which may
+    /// be set to "remote".
+    ///
+    /// \return The current performance profile.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static Profile profile();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Selects the given performance \p profile. Windows and tooltips choose
+    /// their surface format when they are created, hence the profile should
+    /// be selected before creating the first QOffice widget.
+    ///
+    /// \param[in] profile The new performance profile.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void setProfile(Profile profile);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether windows and tooltips have a translucent background
+    /// with a drop shadow, or an opaque one without any shadow.
+    ///
+    /// \return True if translucent, false otherwise.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static bool isTranslucencyEnabled();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether widgets are shown and hidden with an animation, or
+    /// instantly.
+    ///
+    /// \return True if animated, false otherwise.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static bool isAnimationEnabled();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether widgets highlight the part hovered by the mouse.
+    ///
+    /// \return True if hovering is highlighted, false otherwise.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static bool isHoverEnabled();
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficePerformance
+/// \ingroup Design
+///
+/// The remote profile is meant for X11 forwarding and VNC, where every repaint
+/// of a translucent surface is transferred in full. It makes all windows and
+/// tooltips opaque and drops their shadows, shows and hides the ribbon and the
+/// tooltips without animation, and keeps hovered parts flat:
+///
+/// \code
+/// QApplication app(argc, argv);
+/// OfficePerformance::setProfile(OfficePerformance::RemoteProfile);
+/// \endcode
+///
+/// Alternatively, set QOFFICE_PERFORMANCE_PROFILE=remote in the environment
+/// of the application, which requires no change to the application at all.
+///
+////////////////////////////////////////////////////////////////////////////////
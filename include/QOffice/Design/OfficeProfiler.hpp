@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Design module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#ifndef QOFFICE_DESIGN_OFFICEPROFILER_HPP
+#define QOFFICE_DESIGN_OFFICEPROFILER_HPP
+
+#include <QOffice/Config.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficeProfiler
+/// \brief Records timings and counters of QOffice's hot paths.
+///
+////////////////////////////////////////////////////////////////////////////////
+class QOFFICE_DESIGN_API OfficeProfiler
+{
+public:
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Measures the lifetime of a scope.
+    /// \class Scope
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    class Scope
+    {
+    public:
+
+        OffDisableCopy(Scope)
+        OffDisableMove(Scope)
+
+        ////////////////////////////////////////////////////////////////////////
+        /// Starts measuring the scope with the given \p name. The name must be
+        /// a string literal, since only its address is recorded.
+        ///
+        /// \param[in] name The name of the scope.
+        ///
+        ////////////////////////////////////////////////////////////////////////
+        Scope(const char* name);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// Stops measuring the scope and records it.
+        ///
+        ////////////////////////////////////////////////////////////////////////
+        ~Scope();
+
+    private:
+
+        const char* m_name;
+        qint64      m_start;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Enables or disables recording at runtime. The profiler is disabled by
+    /// default, in which case every probe costs a single atomic load.
+    ///
+    /// \param[in] enabled True to start recording, false to stop.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether the profiler is currently recording.
+    ///
+    /// \return True if recording, false otherwise.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Records the given counter \p value under the given \p name. The name
+    /// must be a string literal, since only its address is recorded.
+    ///
+    /// \param[in] name The name of the counter.
+    /// \param[in] value The current value of the counter.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void count(const char* name, qint64 value);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Discards all events recorded so far.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static void clear();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Exports all recorded events in the Chrome trace-event format, which
+    /// can be loaded into chrome://tracing or Perfetto. Each thread keeps only
+    /// its latest events, older ones are overwritten.
+    ///
+    /// \return The trace as JSON document.
+    ///
+    /// \threadsafe This function is thread-safe.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static QByteArray exportChromeTrace();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Exports all recorded events into the file at the given \p path.
+    ///
+    /// \param[in] path The path of the JSON file to write.
+    /// \return True if the file has been written, false otherwise.
+    ///
+    /// \sa OfficeProfiler::exportChromeTrace
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    static bool saveChromeTrace(const QString& path);
+
+private:
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    static qint64 timestamp();
+    static void record(const char*, char, qint64, qint64);
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficeProfiler
+/// \ingroup Design
+///
+/// The probes in QOffice are compiled out unless QOFFICE_ENABLE_PROFILER is
+/// defined, which is done by adding "qoffice_profiler" to the CONFIG variable
+/// when building QOffice. Even then, nothing is recorded until it is enabled:
+///
+/// \code
+/// OfficeProfiler::setEnabled(true);
+/// app.exec();
+/// OfficeProfiler::saveChromeTrace("qoffice-trace.json");
+/// \endcode
+///
+/// Every thread records into a ring buffer of its own, therefore recording
+/// never takes a lock. A lock is only taken once per thread, when its buffer
+/// is registered for the export.
+///
+/// Instead of using this class directly, the hot paths are instrumented with
+/// the OffProfileScope and OffProfileCount macros, which expand to nothing if
+/// the profiler is compiled out.
+///
+////////////////////////////////////////////////////////////////////////////////
@@ -26,9 +26,12 @@
 
 #include <QOffice/Widgets/OfficeWidget.hpp>
 #include <QOffice/Widgets/OfficeWindowMenu.hpp>
-#include <QOffice/Widgets/Dialogs/OfficeWindowResizeArea.hpp>
+#include <QOffice/Widgets/Dialogs/OfficeWindowDebugOverlay.hpp>
 #include <QOffice/Widgets/Dialogs/OfficeWindowTitlebar.hpp>
 
+#include <QFutureWatcher>
+#include <QSharedPointer>
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \class OfficeWindow
 /// \brief This class defines a window in a modern look and feel.
@@ -44,6 +47,15 @@ public:
     /// \brief Defines flags that can modify the behaviour of OfficeWindow.
     /// \enum Flag
     ///
+    /// SystemMoveResize hands interactive moving and resizing over to the
+    /// window system (requires Qt 5.15). If the platform does not support it,
+    /// the window is moved and resized by QOffice itself.
+    ///
+    /// NoShadow omits the drop shadow, which makes the window surface opaque
+    /// and avoids alpha compositing of the entire window. The window is then
+    /// resized through a thin grip along its edges. The remote profile of
+    /// OfficePerformance implies this flag.
+    ///
     ////////////////////////////////////////////////////////////////////////////
     enum Flags
     {
@@ -53,7 +65,9 @@ public:
         NoMaximizeButton = 0x0004,
         NoResize         = 0x0008,
         NoMaximize       = 0x0010,
-        NoMenu           = 0x0020
+        NoMenu           = 0x0020,
+        SystemMoveResize = 0x0040,
+        NoShadow         = 0x0080
     };
 
     OffDefaultDtor(OfficeWindow)
@@ -117,6 +131,16 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     bool isActive() const;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether the debug overlay is shown on top of this window.
+    ///
+    /// \return True if the debug overlay is shown, false otherwise.
+    ///
+    /// \sa OfficeWindow::setDebugOverlayEnabled
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool isDebugOverlayEnabled() const;
+
     ////////////////////////////////////////////////////////////////////////////
     /// Retrieves the current flags of this OfficeWindow.
     ///
@@ -205,6 +229,43 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     void setFlags(Flags flags);
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Shows or hides the debug overlay. The overlay displays the paint time
+    /// of the latest frames, the number of repaints per widget class and
+    /// flashes every dirty region of this window. It can also be enabled for
+    /// all windows by setting the QOFFICE_DEBUG_OVERLAY environment variable.
+    ///
+    /// \param[in] enabled True to show the debug overlay.
+    ///
+    /// \sa OfficeWindow::isDebugOverlayEnabled
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setDebugOverlayEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Saves the state of this window into a compact binary snapshot. It holds
+    /// the normal geometry, whether the window is maximized and the state of
+    /// every OfficeMenu within this window.
+    ///
+    /// \return The snapshot, to be passed to OfficeWindow::restoreState.
+    ///
+    /// \sa OfficeMenu::saveState
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    QByteArray saveState() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Restores the state saved by OfficeWindow::saveState in a single pass.
+    /// The menus are matched by their order within this window.
+    ///
+    /// \param[in] state The snapshot to restore.
+    /// \return True if restored, false if \p state is not a valid snapshot.
+    ///
+    /// \sa OfficeMenu::restoreState
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool restoreState(const QByteArray& state);
+
     ////////////////////////////////////////////////////////////////////////////
     /// Retrieves the currently active window.
     ///
@@ -237,8 +298,16 @@ protected:
     virtual void focusInEvent(QFocusEvent*) override;
     virtual void focusOutEvent(QFocusEvent*) override;
     virtual void showEvent(QShowEvent*) override;
+    virtual void mouseMoveEvent(QMouseEvent*) override;
+    virtual void mousePressEvent(QMouseEvent*) override;
+    virtual void mouseReleaseEvent(QMouseEvent*) override;
     virtual bool event(QEvent*) override;
 
+private slots:
+
+    void dropShadowGenerated();
+    void screenChanged();
+
 private:
 
     ////////////////////////////////////////////////////////////////////////////
@@ -246,27 +315,32 @@ private:
     ////////////////////////////////////////////////////////////////////////////
     void generateDropShadow();
     void updateResizeRectangles();
-    void updateResizeWidgets();
+    void updateResizeCursor(ResizeDirection);
+    bool startSystemMove();
+    bool startSystemResize(ResizeDirection);
+    void resizeTo(const QPoint&);
+    ResizeDirection resizeDirectionAt(const QPoint&) const;
     void updateLayoutPadding();
+    void updateTranslucency();
+    bool hasShadow() const;
+    int  shadowPadding() const;
 
     ////////////////////////////////////////////////////////////////////////////
     // Members
     ////////////////////////////////////////////////////////////////////////////
-    priv::ResizeArea* m_resizeTopLeft;
-    priv::ResizeArea* m_resizeTopRight;
-    priv::ResizeArea* m_resizeBottomLeft;
-    priv::ResizeArea* m_resizeBottomRight;
-    priv::ResizeArea* m_resizeTop;
-    priv::ResizeArea* m_resizeLeft;
-    priv::ResizeArea* m_resizeBottom;
-    priv::ResizeArea* m_resizeRight;
     priv::Titlebar*   m_titleBar;
     WindowState       m_stateWindow;
+    ResizeDirection   m_resizeDirection;
+    Qt::CursorShape   m_resizeCursor;
     Flags             m_flagsWindow;
     QPixmap           m_dropShadow;
     QRect             m_clientRectangle;
     bool              m_tooltipVisible;
 
+    priv::DebugOverlay*        m_debugOverlay;
+    QFutureWatcher<QImage>*    m_shadowWatcher;
+    QSharedPointer<QAtomicInt> m_shadowGeneration;
+
     ////////////////////////////////////////////////////////////////////////////
     // Metadata
     ////////////////////////////////////////////////////////////////////////////
@@ -277,7 +351,7 @@ private:
     Q_PROPERTY(bool MinimizeButton READ hasMinimizeButton WRITE setMinimizeButtonVisible)
     Q_PROPERTY(Office::Accent Accent READ accent WRITE setAccent)
 
-    friend class priv::ResizeArea;
+    friend class priv::DebugOverlay;
     friend class priv::Titlebar;
     friend class OfficeTooltip;
 };
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#ifndef QOFFICE_WIDGETS_DIALOGS_OFFICEWINDOWDEBUGOVERLAY_HPP
+#define QOFFICE_WIDGETS_DIALOGS_OFFICEWINDOWDEBUGOVERLAY_HPP
+
+#include <QOffice/Config.hpp>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include <QWidget>
+
+class OfficeWindow;
+
+namespace priv
+{
+class DebugOverlay : public QWidget
+{
+public:
+
+    OffDisableCopy(DebugOverlay)
+    OffDisableMove(DebugOverlay)
+
+    DebugOverlay(OfficeWindow* window);
+    ~DebugOverlay();
+
+    void addFrame(qint64 nsecs);
+
+protected:
+
+    virtual bool eventFilter(QObject*, QEvent*) override;
+    virtual void paintEvent(QPaintEvent*) override;
+    virtual void timerEvent(QTimerEvent*) override;
+
+private:
+
+    struct Flash
+    {
+        QRect  rect;
+        qint64 time;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    void recordPaint(QWidget*, const QRect&);
+    void syncGeometry();
+    void rotateStatistics();
+    QString className(QObject*);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Members
+    ////////////////////////////////////////////////////////////////////////////
+    OfficeWindow*                 m_window;
+    QElapsedTimer                 m_clock;
+    QHash<const char*,QString>    m_classNames;
+    QHash<QString,int>            m_paintCounts;
+    QVector<QPair<QString,int>>   m_lastCounts;
+    QVector<Flash>                m_flashes;
+    qint64                        m_lastRotation;
+    qint64                        m_frameLast;
+    qint64                        m_frameMax;
+    qint64                        m_frameSum;
+    int                           m_frameCount;
+    double                        m_frameAverage;
+    qint64                        m_frameWorst;
+    int                           m_framesPerSecond;
+    int                           m_timerId;
+};
+}
+
+#endif
@@ -25,13 +25,14 @@
 #define QOFFICE_WIDGETS_DIALOGS_OFFICEWINDOWTITLEBAR_HPP
 
 #include <QOffice/Widgets/OfficeWindowMenu.hpp>
+#include <QFont>
+#include <QVector>
 #include <QWidget>
 
 class OfficeWindow;
 
 namespace priv
 {
-class ResizeArea;
 class Titlebar : public QWidget
 {
 public:
@@ -44,6 +45,33 @@ public:
         ButtonSpecial
     };
 
+    enum Button
+    {
+        CloseButton,
+        MaximizeButton,
+        MinimizeButton,
+        ButtonCount
+    };
+
+    struct CaptionButton
+    {
+        QRect       rect;
+        ButtonState state;
+        int         hideFlag;
+    };
+
+    struct TitleElision
+    {
+        QString        title;
+        QFont          font;
+        QVector<int>   boundaries;
+        QVector<qreal> advances;
+        qreal          fullWidth;
+        qreal          ellipsisWidth;
+        bool           isBidi;
+        int            validFrom;
+        int            validTo;
+    };
 
     OffDefaultDtor(Titlebar)
     OffDisableCopy(Titlebar)
@@ -67,14 +95,19 @@ private:
     ////////////////////////////////////////////////////////////////////////////
     void updateRectangles(); // drag rect too
     void updateVisibleTitle();
+    void shapeTitle(const QString&);
+    void elideTitle(int);
     bool mouseMoveDrag(const QPoint&);
-    bool mouseMoveSpecial(const QPoint&);
-    bool mouseMoveHitTest(const QPoint&);
+    void mouseMoveHitTest(const QPoint&);
     bool mousePressDrag(const QPoint&);
-    bool mousePressHitTest(const QPoint&);
+    void mousePressHitTest(const QPoint&);
     bool mouseReleaseDrag(const QPoint&);
-    bool mouseReleaseAction(const QPoint&);
-    QRect centerRectangle(const QPixmap&, const QRect&);
+    void mouseReleaseAction(const QPoint&);
+    void triggerButton(int);
+    int  buttonAt(const QPoint&) const;
+    int  activeButton() const;
+    void setButtonState(int, ButtonState);
+    void resetButtons();
 
     ////////////////////////////////////////////////////////////////////////////
     // Members
@@ -82,24 +115,16 @@ private:
     OfficeWindow*     m_window;
     OfficeWindowMenu* m_windowLabelMenu;
     OfficeWindowMenu* m_windowQuickMenu;
-    ButtonState       m_stateClose;
-    ButtonState       m_stateMaximize;
-    ButtonState       m_stateMinimize;
-    QPixmap           m_imageClose;
-    QPixmap           m_imageMaximize;
-    QPixmap           m_imageMinimize;
-    QPixmap           m_imageRestore;
+    CaptionButton     m_buttons[ButtonCount];
     QString           m_visibleTitle;
+    TitleElision      m_elision;
     QPoint            m_dragPosition;
     QRect             m_titleRectangle;
+    QRect             m_visibleTitleRectangle;
     QRect             m_dragRectangle;
-    QRect             m_closeRectangle;
-    QRect             m_maximizeRectangle;
-    QRect             m_minimizeRectangle;
 
     friend class OfficeWindow;
     friend class OfficeWindowMenu;
-    friend class priv::ResizeArea;
 
 };
 }
@@ -55,6 +55,9 @@ public:
     OfficeMenuTextboxItem(const QString& initialText = QString());
 
     QWidget* widget() override;
+    QByteArray saveState() const override;
+    bool restoreState(const QByteArray& state) override;
+    QString searchText() override;
 
 private slots:
 
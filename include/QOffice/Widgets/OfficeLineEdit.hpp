@@ -99,6 +99,15 @@ protected:
 
     virtual void keyPressEvent(QKeyEvent*) override; // check format rules.
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Replaces the text without emitting OfficeLineEdit::contentChanged or
+    /// any of the QLineEdit signals, e.g. when restoring a saved session.
+    ///
+    /// \param[in] text The text to restore.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void restoreText(const QString& text);
+
 private slots:
 
      void generateEvent();
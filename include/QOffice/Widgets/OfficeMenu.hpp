@@ -33,8 +33,13 @@ class OfficeMenuButtonClickedEvent;
 class OfficeMenuItemChangedEvent;
 class OfficeMenuHeader;
 class OfficeMenuItem;
+class OfficeMenuPanel;
+class OfficeLineEdit;
+class QCompleter;
 class QHBoxLayout;
-namespace priv { class PinButton; }
+class QModelIndex;
+class QStringListModel;
+namespace priv { class CommandIndex; class KeyTips; class PinButton; }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \class OfficeMenu
@@ -169,6 +174,92 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     void collapse();
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Saves the state of this menu into a compact binary snapshot. It consists
+    /// of the expanded header, whether the menu is pinned and the state of all
+    /// items that provide one, e.g. the text of textboxes or whether toggable
+    /// light items are toggled.
+    ///
+    /// \return The snapshot, to be passed to OfficeMenu::restoreState.
+    ///
+    /// \sa OfficeMenuItem::saveState
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    QByteArray saveState() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Restores the state saved by OfficeMenu::saveState in a single pass. The
+    /// menu is expanded without any animation and no signals are emitted, as
+    /// neither the user nor the application changed anything.
+    ///
+    /// Items are looked up by their header, panel and item IDs. Items that do
+    /// not exist anymore are skipped, so the menu may change in between.
+    ///
+    /// \param[in] state The snapshot to restore.
+    /// \return True if restored, false if \p state is not a valid snapshot.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool restoreState(const QByteArray& state);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether an unpinned menu floats above the content while it
+    /// is expanded.
+    ///
+    /// \return True if floating, false if it takes layout space.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool isOverlayExpansion() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies whether an unpinned menu floats above the content while it is
+    /// expanded. By default, expanding the menu increases its height in the
+    /// layout and thus pushes the content below it down. In overlay mode only
+    /// a pinned menu takes layout space, which saves relayouting expensive
+    /// content on every temporary expansion.
+    ///
+    /// \param[in] overlay True to float above the content, false otherwise.
+    ///
+    /// \remarks The content has to be a sibling of this menu, since a widget
+    ///          can only be raised above its siblings.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setOverlayExpansion(bool overlay);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether the "Tell me" search field is visible.
+    ///
+    /// \return True if visible, false otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool isSearchVisible() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Shows or hides the "Tell me" search field next to the headers. Choosing
+    /// one of its results expands the corresponding header and triggers the
+    /// item, just like clicking it would.
+    ///
+    /// \param[in] visible True to show the search field, false to hide it.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setSearchVisible(bool visible);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Finds all items of this menu whose search text, tooltip, panel text or
+    /// ID starts with the words of the given \p query. Items matched by their
+    /// search text come first.
+    ///
+    /// \param[in] query The words to search for, case-insensitive.
+    /// \param[in] maximum The maximum amount of results, -1 for all of them.
+    /// \return The matching items.
+    ///
+    /// \remarks Light items are found by the search field, but are not part of
+    ///          the result, since they are no OfficeMenuItem.
+    ///
+    /// \sa OfficeMenuItem::searchText
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    QList<OfficeMenuItem*> findCommands(const QString& query, int maximum = -1) const;
+
     ////////////////////////////////////////////////////////////////////////////
     /// Retrieves the desired size for this widget.
     ///
@@ -215,32 +306,65 @@ signals:
     ////////////////////////////////////////////////////////////////////////////
     void itemChangedEvent(OfficeMenuItemChangedEvent* event);
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// This signal is emitted if the user chose an item in the search field.
+    /// The item has already been triggered when this signal is emitted. Light
+    /// items emit OfficeMenu::buttonClickedEvent instead.
+    ///
+    /// \param[in] item The item that has been chosen.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void commandActivated(OfficeMenuItem* item);
+
 protected:
 
     virtual void accentUpdateEvent() override;
     virtual void paintEvent(QPaintEvent*) override;
+    virtual void resizeEvent(QResizeEvent*) override;
     virtual void focusOutEvent(QFocusEvent*) override;
     virtual bool eventFilter(QObject*, QEvent*) override;
 
+private slots:
+
+    void searchTextChanged(const QString&);
+    void searchResultActivated(const QModelIndex&);
+
 private:
 
     void collapseOnFocusLost();
+    void invalidateKeyTips();
+    void activateItem(OfficeMenuItem*);
+    void activateLightItem(OfficeMenuPanel*, int);
+    void revealPanel(OfficeMenuPanel*);
+    void updateHeight();
+    void collapseFinished();
 
     ////////////////////////////////////////////////////////////////////////////
     // Members
     ////////////////////////////////////////////////////////////////////////////
-    QList<OfficeMenuHeader*> m_headers;
-    QHBoxLayout*             m_headerLayout;
-    QHBoxLayout*             m_panelLayout;
-    bool                     m_isExpanded;
-    bool                     m_isPinned;
-    bool                     m_isTooltipShown;
+    QList<OfficeMenuHeader*>           m_headers;
+    QHBoxLayout*                       m_headerLayout;
+    QHBoxLayout*                       m_panelLayout;
+    priv::KeyTips*                     m_keyTips;
+    priv::CommandIndex*                m_commandIndex;
+    OfficeLineEdit*                    m_searchBox;
+    QCompleter*                        m_searchCompleter;
+    QStringListModel*                  m_searchModel;
+    QList<QPair<OfficeMenuPanel*,int>> m_searchResults;
+    bool                               m_isExpanded;
+    bool                               m_isPinned;
+    bool                               m_isTooltipShown;
+    bool                               m_isOverlay;
+    bool                               m_isFloating;
 
     ////////////////////////////////////////////////////////////////////////////
     // Metadata
     ////////////////////////////////////////////////////////////////////////////
     Q_OBJECT
 
+    friend class OfficeMenuHeader;
+    friend class OfficeMenuPanel;
+    friend class priv::KeyTips;
     friend class priv::PinButton;
 };
 
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#ifndef QOFFICE_WIDGETS_OFFICEMENUCOMMANDINDEX_HPP
+#define QOFFICE_WIDGETS_OFFICEMENUCOMMANDINDEX_HPP
+
+#include <QOffice/Config.hpp>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPair>
+#include <QVector>
+
+class OfficeMenu;
+class OfficeMenuItem;
+class OfficeMenuLightItem;
+class OfficeMenuPanel;
+
+namespace priv
+{
+class CommandIndex : public QObject
+{
+public:
+
+    OffDefaultDtor(CommandIndex)
+    OffDisableCopy(CommandIndex)
+    OffDisableMove(CommandIndex)
+
+    // Items and light items alike are identified by their panel and ID.
+    typedef QPair<OfficeMenuPanel*,int> Key;
+
+    CommandIndex(OfficeMenu* menu);
+
+    void insert(OfficeMenuItem* item);
+    void insert(OfficeMenuPanel* panel, int id, const OfficeMenuLightItem& item);
+    void remove(OfficeMenuPanel* panel, int id);
+    QList<Key> find(const QString& query, int maximum);
+
+private:
+
+    struct Token
+    {
+        QString text;
+        int     rank;
+    };
+
+    struct Entry
+    {
+        Key                     key;
+        QVector<Token>          tokens;
+        QMetaObject::Connection connection;
+        int                     sequence;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    static void tokenize(const QString&, int, QVector<Token>&);
+    static int  score(const Entry&, const QVector<Token>&);
+    static bool refines(const QVector<Token>&, const QVector<Token>&);
+    void insert(const Key&, Entry&, QObject*);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Members
+    ////////////////////////////////////////////////////////////////////////////
+    QVector<Entry>             m_entries;
+    QVector<int>               m_freeSlots;
+    QVector<int>               m_marks;
+    QHash<Key,int>             m_slots;
+    QMap<QString,QVector<int>> m_tokens;
+    QVector<Token>             m_lastWords;
+    QVector<int>               m_lastMatches;
+    int                        m_generation;
+    int                        m_lastGeneration;
+    int                        m_stamp;
+    int                        m_sequence;
+};
+}
+
+#endif
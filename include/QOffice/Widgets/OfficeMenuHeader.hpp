@@ -25,13 +25,13 @@
 #define QOFFICE_WIDGET_OFFICEMENUHEADER_HPP
 
 #include <QOffice/Config.hpp>
+#include <QHash>
 #include <QWidget>
 
 class OfficeMenu;
 class OfficeMenuPanel;
-class QGraphicsOpacityEffect;
 class QHBoxLayout;
-namespace priv { class PanelBar; }
+namespace priv { class KeyTips; class PanelBar; class PanelButton; class PanelSnapshot; class PinButton; }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \class OfficeMenuHeader
@@ -207,7 +207,11 @@ private:
     // Functions
     ////////////////////////////////////////////////////////////////////////////
     void expand(QHBoxLayout*,bool);
+    void setHovered(bool);
     void collapse(QHBoxLayout*,bool);
+    void updateTiers(int);
+    void invalidateTiers();
+    void applyTier(OfficeMenuPanel*,int);
 
     ////////////////////////////////////////////////////////////////////////////
     // Members
@@ -215,14 +219,17 @@ private:
     OfficeMenu*             m_parent;       ///< Defines the parent office menu.
     priv::PanelBar*         m_panelBar;     ///< Defines the panel bar widget.
     QHBoxLayout*            m_panelLayout;  ///< Defines the panel layout.
-    QGraphicsOpacityEffect* m_effectIn;     ///< Defines the fade in opac effect.
-    QPropertyAnimation*     m_animationIn;  ///< Defines the fade in animation.
-    QPropertyAnimation*     m_animationOut; ///< Defines the fade out animation.
+    priv::PanelSnapshot*    m_snapshot;     ///< Defines the animated snapshot.
+    priv::PinButton*        m_pinButton;    ///< Defines the pin button.
+    int                     m_animationIn;  ///< Identifies the in animation.
+    int                     m_animationOut; ///< Identifies the out animation.
     QList<OfficeMenuPanel*> m_panels;       ///< Holds all panels of this header.
+    QHash<OfficeMenuPanel*, priv::PanelButton*> m_panelButtons;
     QString                 m_text;         ///< Defines the displayed header text.
     bool                    m_isHovered;    ///< Determines whether its hovered.
     bool                    m_isSelected;   ///< Determines whether its selected.
     int                     m_id;           ///< Defines the unique ID.
+    int                     m_tierWidth;    ///< Defines the width tiers fit in.
 
     ////////////////////////////////////////////////////////////////////////////
     // Metadata
@@ -230,6 +237,8 @@ private:
     Q_OBJECT
 
     friend class OfficeMenu;
+    friend class OfficeMenuPanel;
+    friend class priv::KeyTips;
 };
 
 #endif
@@ -25,7 +25,9 @@
 #define QOFFICE_WIDGET_OFFICEMENUITEM_HPP
 
 #include <QOffice/Config.hpp>
+#include <QByteArray>
 #include <QObject>
+#include <QString>
 
 class OfficeMenuEvent;
 class OfficeMenuPanel;
@@ -84,6 +86,39 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     virtual QWidget* widget() = 0;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Saves the state of this item, e.g. the text of a textbox. Items without
+    /// any state return a null byte array, which is the default.
+    ///
+    /// \return The state of this item.
+    ///
+    /// \sa OfficeMenu::saveState
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    virtual QByteArray saveState() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Restores the state saved by OfficeMenuItem::saveState. Implementations
+    /// should not emit any item events while doing so.
+    ///
+    /// \param[in] state The state to restore.
+    /// \return True if restored, false if \p state is invalid.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    virtual bool restoreState(const QByteArray& state);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the text by which this item is found in the command search.
+    /// Defaults to the text of button items and to the accessible name of any
+    /// other widget. The tooltip and the panel text are searched as well.
+    ///
+    /// \return The searchable text of this item.
+    ///
+    /// \sa OfficeMenu::findCommands
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    virtual QString searchText();
+
 protected:
 
     ////////////////////////////////////////////////////////////////////////////
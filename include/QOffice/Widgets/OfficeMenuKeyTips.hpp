@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#ifndef QOFFICE_WIDGETS_OFFICEMENUKEYTIPS_HPP
+#define QOFFICE_WIDGETS_OFFICEMENUKEYTIPS_HPP
+
+#include <QOffice/Config.hpp>
+#include <QHash>
+#include <QPair>
+#include <QPointer>
+#include <QVector>
+#include <QWidget>
+
+class OfficeMenu;
+class OfficeMenuHeader;
+class OfficeMenuItem;
+class QKeyEvent;
+
+namespace priv
+{
+class PanelButton;
+
+class KeyTips : public QWidget
+{
+public:
+
+    OffDefaultDtor(KeyTips)
+    OffDisableCopy(KeyTips)
+    OffDisableMove(KeyTips)
+
+    KeyTips(OfficeMenu* menu);
+
+    bool isActive() const;
+    void activate();
+    void deactivate(bool restoreFocus);
+    void invalidate();
+
+protected:
+
+    virtual void paintEvent(QPaintEvent*) override;
+    virtual bool eventFilter(QObject*, QEvent*) override;
+
+private:
+
+    enum Level
+    {
+        HeaderLevel,
+        ItemLevel
+    };
+
+    enum Direction
+    {
+        Left,
+        Up,
+        Right,
+        Down,
+        DirectionCount
+    };
+
+    struct Node
+    {
+        QWidget*          widget;
+        OfficeMenuHeader* header;
+        OfficeMenuItem*   item;
+        PanelButton*      button;
+        int               light;
+        QString           tip;
+        qreal             x;
+        qreal             y;
+        int               next[DirectionCount];
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    static bool isHeader(const Node&);
+    void updateGraph();
+    void linkItems(int, int);
+    void assignTips(int, int, bool);
+    bool belongsToWindow(QObject*) const;
+    bool keyPress(QKeyEvent*);
+    void typeTip(const QString&);
+    void move(Direction);
+    void trigger(int);
+    void setCurrent(int);
+    int  currentNode();
+    QRect nodeRect(const Node&) const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Members
+    ////////////////////////////////////////////////////////////////////////////
+    OfficeMenu*                    m_menu;
+    QVector<Node>                  m_nodes;
+    QHash<QPair<QWidget*,int>,int> m_nodeIndex;
+    QPointer<QWidget>              m_current;
+    int                            m_currentLight;
+    QPointer<QWidget>              m_previousFocus;
+    QString                        m_typed;
+    Level                          m_level;
+    int                            m_firstItem;
+    bool                           m_isActive;
+    bool                           m_isGraphValid;
+    bool                           m_isAltPending;
+};
+}
+
+#endif
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#ifndef QOFFICE_WIDGETS_OFFICEMENULIGHTITEM_HPP
+#define QOFFICE_WIDGETS_OFFICEMENULIGHTITEM_HPP
+
+#include <QOffice/Config.hpp>
+#include <QPixmap>
+#include <QString>
+#include <functional>
+
+class OfficeMenuItem;
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficeMenuLightItem
+/// \brief Defines a menu item without a widget of its own.
+///
+////////////////////////////////////////////////////////////////////////////////
+class QOFFICE_WIDGET_API OfficeMenuLightItem
+{
+public:
+
+    OffDefaultCopy(OfficeMenuLightItem)
+    OffDefaultMove(OfficeMenuLightItem)
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \enum Size
+    /// \brief Defines the sizes a light item can be painted in.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    enum Size
+    {
+        Small, ///< The icon is placed left to the text, one of three rows.
+        Large  ///< The icon is placed above the text, spanning all rows.
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Creates a function that turns this item into a real widget once it
+    /// needs the focus, e.g. for entering text.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    typedef std::function<OfficeMenuItem* ()> EditorFactory;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Initializes a new instance of OfficeMenuLightItem with the given \p text
+    /// and \p icon.
+    ///
+    /// \param[in] text The displayed text of the item.
+    /// \param[in] icon The displayed icon of the item.
+    /// \param[in] size The size of the item.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    OfficeMenuLightItem(
+        const QString& text = QString(),
+        const QPixmap& icon = QPixmap(),
+        Size size = Small
+        );
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the displayed text of this item.
+    ///
+    /// \return The displayed text.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    const QString& text() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the displayed icon of this item.
+    ///
+    /// \return The displayed icon.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    const QPixmap& icon() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the tooltip of this item.
+    ///
+    /// \return The tooltip text.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    const QString& toolTip() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the size of this item.
+    ///
+    /// \return The size of this item.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    Size size() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether this item is enabled.
+    ///
+    /// \return True if enabled, false otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool isEnabled() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether this item toggles when clicked.
+    ///
+    /// \return True if toggable, false otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool isToggable() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Determines whether this item is toggled.
+    ///
+    /// \return True if toggled, false otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool isToggled() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the function that turns this item into a real widget.
+    ///
+    /// \return The editor factory, which might be empty.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    const EditorFactory& editorFactory() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies the displayed text of this item.
+    ///
+    /// \param[in] text The new displayed text.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setText(const QString& text);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies the displayed icon of this item.
+    ///
+    /// \param[in] icon The new displayed icon.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setIcon(const QPixmap& icon);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies the tooltip of this item.
+    ///
+    /// \param[in] toolTip The new tooltip text.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setToolTip(const QString& toolTip);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies the size of this item.
+    ///
+    /// \param[in] size The new size of this item.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setSize(Size size);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies whether this item is enabled.
+    ///
+    /// \param[in] enabled True to enable, false to disable.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies whether this item toggles when clicked.
+    ///
+    /// \param[in] toggable True to toggle when clicked, false otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setToggable(bool toggable);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies whether this item is toggled.
+    ///
+    /// \param[in] toggled True to toggle, false otherwise.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setToggled(bool toggled);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Specifies the function that turns this item into a real widget, once
+    /// it is clicked. The item is replaced by the created one for good.
+    ///
+    /// \param[in] factory The editor factory.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    void setEditorFactory(const EditorFactory& factory);
+
+private:
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Members
+    ////////////////////////////////////////////////////////////////////////////
+    QString       m_text;       ///< Defines the displayed text.
+    QPixmap       m_icon;       ///< Defines the displayed icon.
+    QString       m_toolTip;    ///< Defines the tooltip text.
+    EditorFactory m_factory;    ///< Creates the widget, if ever needed.
+    Size          m_size;       ///< Defines the size of the item.
+    bool          m_isEnabled;  ///< Determines whether it is enabled.
+    bool          m_isToggable; ///< Determines whether it toggles on click.
+    bool          m_isToggled;  ///< Determines whether it is toggled.
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class OfficeMenuLightItem
+/// \ingroup Widget
+///
+/// Every ::OfficeMenuItem is a QWidget of its own, with an event filter and an
+/// entry in the layout of its panel. Light items are plain data instead. They
+/// are painted and hit-tested by the ::OfficeMenuPanel they belong to, which
+/// makes them suitable for ribbons with many commands:
+///
+/// \code
+/// OfficeMenuLightItem bold(tr("Bold"), boldIcon);
+/// bold.setToggable(true);
+///
+/// m_panel->insertLightItem(id, bold, 0, 0);
+/// \endcode
+///
+/// Clicking a light item emits the OfficeMenu::buttonClickedEvent signal, just
+/// like a button item would. Items that need the focus, e.g. for entering text,
+/// provide an editor factory. Once clicked, the panel replaces the light item
+/// with the created ::OfficeMenuItem, which keeps the ID of the light item.
+///
+////////////////////////////////////////////////////////////////////////////////
@@ -25,12 +25,15 @@
 #define QOFFICE_WIDGET_OFFICEMENUPANEL_HPP
 
 #include <QOffice/Config.hpp>
+#include <QOffice/Widgets/OfficeMenuLightItem.hpp>
+#include <QVector>
 #include <QWidget>
 
 class OfficeMenu;
 class OfficeMenuHeader;
 class OfficeMenuItem;
-class QGridLayout;
+class QSpacerItem;
+namespace priv { class KeyTips; class PanelLayout; }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \class OfficeMenuPanel
@@ -43,6 +46,19 @@ class QOFFICE_WIDGET_API OfficeMenuPanel : public QWidget
 {
 public:
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \enum Tier
+    /// \brief Defines the sizes a panel can be shown in, if space is short.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    enum Tier
+    {
+        LargeTier,     ///< All items are shown as inserted.
+        MediumTier,    ///< Large light items are shown as small ones.
+        SmallTier,     ///< Light items only show their icons.
+        CollapsedTier  ///< The panel is a button that shows it in a popup.
+    };
+
     OffDefaultDtor(OfficeMenuPanel)
     OffDisableCopy(OfficeMenuPanel)
     OffDisableMove(OfficeMenuPanel)
@@ -105,6 +121,37 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     OfficeMenuItem* operator [](int id) const;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the light item with the specified \p id.
+    ///
+    /// \param[in] id The unique identifier of the light item.
+    /// \return The light item corresponding to the given \p id.
+    ///
+    /// \remarks Yields nullptr if id is invalid. The pointer is invalidated by
+    ///          inserting or removing any other light item.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    const OfficeMenuLightItem* lightItemById(int id) const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the tier this panel is currently shown in. The tier is chosen
+    /// by the header, depending on the width of the menu.
+    ///
+    /// \return The current tier.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    Tier tier() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Retrieves the width of this panel in the given \p tier. The widths of
+    /// all tiers are measured once after the contents changed.
+    ///
+    /// \param[in] tier The tier to retrieve the width of.
+    /// \return The width of this panel in \p tier, in pixels.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    int tierWidth(Tier tier) const;
+
     ////////////////////////////////////////////////////////////////////////////
     /// Specifies the unique identifier of this object.
     ///
@@ -151,6 +198,42 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     bool removeItem(int id);
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Inserts a new light item into the panel. Light items do not create any
+    /// widget, they are painted and hit-tested by the panel itself. Like all
+    /// other items, they are found by the search field, reached through key
+    /// tips and saved by OfficeMenu::saveState.
+    ///
+    /// \param id         The unique identifier of the item to insert.
+    /// \param item       The new light item to be inserted into the panel.
+    /// \param row        The layout row to insert item to.
+    /// \param column     The layout column to insert item to.
+    /// \param rowSpan    The amount of rows to span across.
+    /// \param columnSpan The amount of columns to span across.
+    /// \return True if successfully inserted, false otherwise.
+    ///
+    /// \remarks Yields false if the id already exists. Light items are removed
+    ///          through OfficeMenuPanel::removeItem.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool insertLightItem(
+        int id, const OfficeMenuLightItem& item,
+        int row, int column,
+        int rowSpan = 1, int columnSpan = 1);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Replaces the light item with the given \p id, e.g. to change its text
+    /// or toggle state. Only the area of the item is repainted.
+    ///
+    /// \param id   The unique identifier of the item to replace.
+    /// \param item The new data of the light item.
+    /// \return True if successfully replaced, false otherwise.
+    ///
+    /// \remarks Yields false if the id is invalid.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    bool setLightItem(int id, const OfficeMenuLightItem& item);
+
     ////////////////////////////////////////////////////////////////////////////
     /// Retrieves the preferred size for this panel.
     ///
@@ -161,18 +244,57 @@ public:
 
 protected:
 
+    virtual bool event(QEvent*) override;
     virtual void paintEvent(QPaintEvent*) override;
+    virtual void leaveEvent(QEvent*) override;
+    virtual void mouseMoveEvent(QMouseEvent*) override;
+    virtual void mousePressEvent(QMouseEvent*) override;
+    virtual void mouseReleaseEvent(QMouseEvent*) override;
 
 private:
 
+    struct LightSlot
+    {
+        OfficeMenuLightItem item;
+        QSpacerItem*        spacer;
+        int                 id;
+        int                 row;
+        int                 column;
+        int                 rowSpan;
+        int                 columnSpan;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    int lightIndex(int) const;
+    int lightItemAt(const QPoint&) const;
+    QSize lightItemSize(const OfficeMenuLightItem&, Tier) const;
+    void paintLightItem(QPainter&, int);
+    void removeLightItem(int);
+    void triggerLightItem(int);
+    void promoteLightItem(int);
+    void setHoveredLight(int);
+    void setTier(Tier);
+    void invalidateTiers();
+    void calculateTiers() const;
+    static bool isLarge(const OfficeMenuLightItem&, Tier);
+    static bool isIconOnly(const OfficeMenuLightItem&, Tier);
+
     ////////////////////////////////////////////////////////////////////////////
     // Members
     ////////////////////////////////////////////////////////////////////////////
-    QGridLayout*           m_layout; ///< Defines the grid layout of the panel.
-    OfficeMenuHeader*      m_parent; ///< Defines the parent menu header.
-    QList<OfficeMenuItem*> m_items;  ///< Holds all menu items in the panel.
-    QString                m_text;   ///< Defines the text at the panel bottom.
-    int                    m_id;     ///< Defines the unique ID.
+    priv::PanelLayout*     m_layout;       ///< Defines the panel layout.
+    OfficeMenuHeader*      m_parent;       ///< Defines the parent header.
+    QList<OfficeMenuItem*> m_items;        ///< Holds all menu items.
+    QVector<LightSlot>     m_lightItems;   ///< Holds all light items.
+    QString                m_text;         ///< Defines the text at the bottom.
+    int                    m_id;           ///< Defines the unique ID.
+    Tier                   m_tier;         ///< Defines the current tier.
+    int                    m_hoveredLight; ///< Defines the hovered light item.
+    int                    m_pressedLight; ///< Defines the pressed light item.
+    mutable int            m_tierWidths[4]; ///< Holds the tier widths.
+    mutable bool           m_isTierValid;  ///< Determines if widths are valid.
 
     ////////////////////////////////////////////////////////////////////////////
     // Metadata
@@ -181,6 +303,7 @@ private:
 
     friend class OfficeMenu;
     friend class OfficeMenuHeader;
+    friend class priv::KeyTips;
 };
 
 #endif
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+#ifndef QOFFICE_WIDGETS_OFFICEMENUPANELLAYOUT_HPP
+#define QOFFICE_WIDGETS_OFFICEMENUPANELLAYOUT_HPP
+
+#include <QOffice/Config.hpp>
+#include <QLayout>
+#include <QVector>
+
+namespace priv
+{
+class PanelLayout : public QLayout
+{
+public:
+
+    OffDeclareDtor(PanelLayout)
+    OffDisableCopy(PanelLayout)
+    OffDisableMove(PanelLayout)
+
+    PanelLayout(QWidget* parent);
+
+    void addWidget(QWidget* widget, int row, int column, int rowSpan = 1, int columnSpan = 1);
+    void addItem(QLayoutItem* item, int row, int column, int rowSpan = 1, int columnSpan = 1);
+    void getItemPosition(int index, int* row, int* column, int* rowSpan, int* columnSpan) const;
+    int rowCount() const;
+    int columnCount() const;
+    QSize sizeHint(const QVector<QSize>& hints) const;
+    static bool isSkipped(QLayoutItem* item);
+
+    virtual void addItem(QLayoutItem* item) override;
+    virtual int count() const override;
+    virtual QLayoutItem* itemAt(int index) const override;
+    virtual QLayoutItem* takeAt(int index) override;
+    virtual QSize sizeHint() const override;
+    virtual QSize minimumSize() const override;
+    virtual Qt::Orientations expandingDirections() const override;
+    virtual void setGeometry(const QRect& rect) override;
+    virtual void invalidate() override;
+
+private:
+
+    struct Cell
+    {
+        QLayoutItem* item;
+        int          row;
+        int          column;
+        int          rowSpan;
+        int          columnSpan;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    void calculate() const;
+    QSize measure(const QVector<QSize>&, QVector<int>&, QVector<int>&) const;
+    static void distribute(QVector<int>&, int, int, int);
+    static int extent(const QVector<int>&, int, int, int);
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Members
+    ////////////////////////////////////////////////////////////////////////////
+    QVector<Cell>        m_cells;
+    mutable QVector<int> m_columns;
+    mutable QVector<int> m_rows;
+    mutable QSize        m_sizeHint;
+    mutable bool         m_isDirty;
+};
+}
+
+#endif
@@ -20,38 +20,42 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+
 #pragma once
-#ifndef QOFFICE_WIDGETS_DIALOGS_OFFICEWINDOWRESIZEAREA_HPP
-#define QOFFICE_WIDGETS_DIALOGS_OFFICEWINDOWRESIZEAREA_HPP
+#ifndef QOFFICE_WIDGETS_OFFICEMENUPANELSNAPSHOT_HPP
+#define QOFFICE_WIDGETS_OFFICEMENUPANELSNAPSHOT_HPP
 
 #include <QOffice/Config.hpp>
+#include <QPixmap>
 #include <QWidget>
 
-class OfficeWindow;
+class OfficeMenu;
 
 namespace priv
 {
-class ResizeArea : public QWidget
+class PanelSnapshot : public QWidget
 {
 public:
 
-    OffDefaultDtor(ResizeArea)
-    OffDisableCopy(ResizeArea)
-    OffDisableMove(ResizeArea)
+    OffDefaultDtor(PanelSnapshot)
+    OffDisableCopy(PanelSnapshot)
+    OffDisableMove(PanelSnapshot)
+
+    PanelSnapshot(OfficeMenu* parent);
 
-    ResizeArea(OfficeWindow* window, int directions);
+    void capture(QWidget* widget);
+    void release();
 
 protected:
 
-    void enterEvent(QEvent*) override;
-    void mouseMoveEvent(QMouseEvent*) override;
-    void mousePressEvent(QMouseEvent*) override;
-    void mouseReleaseEvent(QMouseEvent*) override;
+    virtual void paintEvent(QPaintEvent*) override;
 
 private:
 
-    OfficeWindow* m_window;
-    int           m_directions;
+    ////////////////////////////////////////////////////////////////////////////
+    // Members
+    ////////////////////////////////////////////////////////////////////////////
+    QPixmap m_pixmap;
 };
 }
 
@@ -54,6 +54,12 @@ protected:
 
 private:
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Functions
+    ////////////////////////////////////////////////////////////////////////////
+    void loadImages(qreal);
+    void setHovered(bool);
+
     ////////////////////////////////////////////////////////////////////////////
     // Members
     ////////////////////////////////////////////////////////////////////////////
@@ -61,6 +67,7 @@ private:
     OfficeTooltip*    m_tooltip;
     QPixmap           m_imgSticky;
     QPixmap           m_imgCollapse;
+    qreal             m_imageRatio;
     bool              m_isHovered;
     bool              m_isPressed;
 };
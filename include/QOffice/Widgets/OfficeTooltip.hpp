@@ -173,6 +173,17 @@ public:
     ////////////////////////////////////////////////////////////////////////////
     void setWaitPeriod(int milliseconds);
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// Shows or hides this tooltip. An opaque tooltip can not be faded in, so
+    /// it is not shown before the wait period is over.
+    ///
+    /// \param[in] visible True to show the tooltip, false to hide it.
+    ///
+    /// \sa OfficePerformance::isTranslucencyEnabled
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+    virtual void setVisible(bool visible) override;
+
 protected:
 
     virtual void paintEvent(QPaintEvent*) override;
@@ -182,6 +193,7 @@ protected:
     virtual void showEvent(QShowEvent*) override;
     virtual void hideEvent(QHideEvent*) override;
     virtual void leaveEvent(QEvent*) override;
+    virtual void timerEvent(QTimerEvent*) override;
 
 signals:
 
@@ -202,16 +214,14 @@ private:
     ////////////////////////////////////////////////////////////////////////////
     void updateRectangles();
     void generateDropShadow();
-    qreal opacity() const;
-    void setOpacity(qreal opacity);
+    int shadowPadding() const;
+    void restartTimer(int, bool);
 
     ////////////////////////////////////////////////////////////////////////////
     // Members
     ////////////////////////////////////////////////////////////////////////////
-    QTimer*             m_timer;
-    QTimer*             m_waitTimer;
-    QPropertyAnimation* m_showAnimation;
-    QPropertyAnimation* m_hideAnimation;
+    QBasicTimer         m_timer;
+    int                 m_fadeAnimation;
     OfficeWindow*       m_activeWindow;
     QString             m_heading;
     QString             m_bodyText;
@@ -231,12 +241,14 @@ private:
     qreal               m_opacity;
     bool                m_isHelpEnabled;
     bool                m_isLinkHovered;
+    bool                m_isDefaultIcon;
+    bool                m_isTranslucent;
+    bool                m_isWaiting;
 
     ////////////////////////////////////////////////////////////////////////////
     // Metadata
     ////////////////////////////////////////////////////////////////////////////
     Q_OBJECT
-    Q_PROPERTY(qreal Opacity READ opacity WRITE setOpacity)
 };
 
 #endif
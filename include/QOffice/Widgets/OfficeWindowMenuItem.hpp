@@ -75,6 +75,9 @@ protected:
 
 private:
 
+    void setPressed(bool);
+    void updateHoverRegion();
+
     int               m_type;      ///< Defines the type of the parent menu.
     int               m_id;        ///< Defines the unique item identifier.
     bool              m_isHovered; ///< Determines whether the item is hovered.
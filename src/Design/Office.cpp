@@ -21,6 +21,18 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <QOffice/Design/Office.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QResource>
+#include <QTextStream>
+
+#ifdef QOFFICE_EXTERNAL_RESOURCES
+OffAnonymous(const char* const c_bundleName = "qoffice.rcc")
+OffAnonymous(const char* const c_bundleVariable = "QOFFICE_RESOURCE_BUNDLE")
+#endif
 
 QString Office::colorToHex(const QColor& color)
 {
@@ -34,6 +46,9 @@ QString Office::colorToHex(const QColor& color)
 
 QString Office::loadStyleSheet(const QString& name)
 {
+    OffProfileScope("Office::loadStyleSheet");
+    ensureResources();
+
     static QString basePath = QStringLiteral(":/qoffice/stylesheets/");
     static QString extension = QStringLiteral(".css");
 
@@ -47,6 +62,14 @@ QString Office::loadStyleSheet(const QString& name)
     return QTextStream(&file).readAll();
 }
 
+bool Office::ensureResources()
+{
+    // The initialization of static locals is thread-safe since C++11, hence
+    // the bundle is looked up exactly once, no matter which thread asks first.
+    static const bool available = registerResources();
+    return available;
+}
+
 bool Office::isAscii(const QString& str)
 {
     foreach (const QChar c, str)
@@ -111,3 +134,46 @@ bool Office::isBinary(const QString& str)
 
     return success;
 }
+
+bool Office::registerResources()
+{
+#ifdef QOFFICE_EXTERNAL_RESOURCES
+    OffProfileScope("Office::registerResources");
+
+    // The application may have compiled the .qrc files into itself, in which
+    // case the embedded resources are used and no bundle is required.
+    if (QFile::exists(QStringLiteral(":/qoffice/stylesheets")))
+    {
+        return true;
+    }
+
+    QStringList candidates;
+    const QString variable = QString::fromLocal8Bit(qgetenv(c_bundleVariable));
+    if (!variable.isEmpty())
+    {
+        candidates.append(variable);
+    }
+
+    if (QCoreApplication::instance() != nullptr)
+    {
+        candidates.append(QDir(QCoreApplication::applicationDirPath()).filePath(c_bundleName));
+    }
+
+    candidates.append(QDir::current().filePath(c_bundleName));
+
+    // Qt maps the bundle into memory instead of reading it, so only the pages
+    // of the fonts and images that are actually used are ever loaded.
+    for (const QString& path : candidates)
+    {
+        if (QFile::exists(path) && QResource::registerResource(path))
+        {
+            return true;
+        }
+    }
+
+    qWarning("QOffice: Could not find the resource bundle %s.", c_bundleName);
+    return false;
+#else
+    return true;
+#endif
+}
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Design module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficeAnimationClock.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
+
+#include <QAbstractAnimation>
+#include <QCoreApplication>
+#include <QPointer>
+#include <QVector>
+
+namespace
+{
+struct ClockTrack
+{
+    int                                  id;
+    QPointer<QObject>                    owner;
+    int                                  start;
+    int                                  duration;
+    QEasingCurve                         curve;
+    OfficeAnimationClock::StepFunction   step;
+    OfficeAnimationClock::FinishFunction finished;
+};
+
+class ClockDriver : public QAbstractAnimation
+{
+public:
+
+    virtual int duration() const override
+    {
+        return -1;
+    }
+
+protected:
+
+    virtual void updateCurrentTime(int currentTime) override;
+};
+}
+
+OffAnonymous(QVector<ClockTrack> g_tracks)
+OffAnonymous(QPointer<ClockDriver> g_driver)
+OffAnonymous(int g_nextId = 1)
+
+namespace
+{
+int indexOf(const QVector<ClockTrack>& tracks, int id)
+{
+    for (int i = 0; i < tracks.size(); ++i)
+    {
+        if (tracks.at(i).id == id)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+}
+
+int OfficeAnimationClock::start(
+    QObject* owner,
+    int duration,
+    const StepFunction& step,
+    const FinishFunction& finished,
+    const QEasingCurve& curve)
+{
+    if (duration <= 0)
+    {
+        step(curve.valueForProgress(1.0));
+        if (finished)
+        {
+            finished();
+        }
+
+        return 0;
+    }
+
+    // The driver is owned by the application, so that it is destroyed along
+    // with the unified animation timer of the GUI thread.
+    if (g_driver.isNull())
+    {
+        g_driver = new ClockDriver;
+        g_driver->setParent(QCoreApplication::instance());
+    }
+
+    // An idle driver starts over at time zero. The track is appended first,
+    // since starting the driver ticks right away and stops it if idle.
+    const bool isIdle = g_driver->state() != QAbstractAnimation::Running;
+
+    ClockTrack track;
+    track.id       = g_nextId++;
+    track.owner    = owner;
+    track.start    = isIdle ? 0 : g_driver->currentTime();
+    track.duration = duration;
+    track.curve    = curve;
+    track.step     = step;
+    track.finished = finished;
+
+    g_tracks.append(track);
+    step(curve.valueForProgress(0.0));
+
+    if (isIdle)
+    {
+        g_driver->start();
+    }
+
+    return track.id;
+}
+
+void OfficeAnimationClock::stop(int id)
+{
+    const int index = indexOf(g_tracks, id);
+    if (index != -1)
+    {
+        g_tracks.remove(index);
+    }
+}
+
+bool OfficeAnimationClock::isRunning(int id)
+{
+    return indexOf(g_tracks, id) != -1;
+}
+
+void ClockDriver::updateCurrentTime(int time)
+{
+    OffProfileScope("OfficeAnimationClock::tick");
+
+    // The step functions may start and stop animations, therefore they work
+    // on a copy. Every animation is advanced to the same frame time.
+    const QVector<ClockTrack> tracks = g_tracks;
+    QVector<int> finished;
+
+    for (const ClockTrack& track : tracks)
+    {
+        if (!OfficeAnimationClock::isRunning(track.id))
+        {
+            continue;
+        }
+
+        if (track.owner.isNull())
+        {
+            OfficeAnimationClock::stop(track.id);
+            continue;
+        }
+
+        const int elapsed = time - track.start;
+        const qreal progress = qMin(1.0, static_cast<qreal>(elapsed) / track.duration);
+
+        track.step(track.curve.valueForProgress(progress));
+        if (progress >= 1.0)
+        {
+            finished.append(track.id);
+        }
+    }
+
+    // Finish functions run after all animations took their step, since they
+    // usually swap widgets and should see the final frame of every animation.
+    for (int id : finished)
+    {
+        const int index = indexOf(g_tracks, id);
+        if (index == -1)
+        {
+            continue;
+        }
+
+        const ClockTrack track = g_tracks.takeAt(index);
+        if (!track.owner.isNull() && track.finished)
+        {
+            track.finished();
+        }
+    }
+
+    // No timer keeps waking up the GUI thread while nothing is animated.
+    if (g_tracks.isEmpty())
+    {
+        stop();
+    }
+
+    OffProfileCount("OfficeAnimationClock::tracks", g_tracks.size());
+}
@@ -20,7 +20,9 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <QOffice/Design/Office.hpp>
 #include <QOffice/Design/OfficeFont.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 
 #include <QFontDatabase>
 #include <QMutex>
@@ -31,6 +33,8 @@ OffAnonymous(QMap<uint,QFont> g_fonts)
 
 const QFont& OfficeFont::font(Weight weight, float pointSize)
 {
+    OffProfileScope("OfficeFont::font");
+
     auto weightValue = static_cast<int>(weight);
     if (!isValid(weight))
     {
@@ -49,6 +53,7 @@ const QFont& OfficeFont::font(Weight weight, float pointSize)
         {
             // Font itself is not loaded yet. We use the QFontDatabase in order
             // to load a font from the resources.
+            Office::ensureResources();
             index = QFontDatabase::addApplicationFont(fontPath(weightValue));
 
             g_mutex.lock();
@@ -79,7 +84,10 @@ const QFont& OfficeFont::font(Weight weight, float pointSize)
 
         // Creates a new cache entry for the font and directly returns it.
         QMutexLocker locker(&g_mutex);
-        return g_fonts.insert(key, font).value();
+        auto entry = g_fonts.insert(key, font);
+
+        OffProfileCount("OfficeFont::cacheSize", g_fonts.size());
+        return entry.value();
     }
 
     // It is now ensured that there always is a font for the given properties.
@@ -20,14 +20,23 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <QOffice/Design/Office.hpp>
 #include <QOffice/Design/OfficeImage.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 
-#include <QGraphicsScene>
-#include <QGraphicsPixmapItem>
-#include <QGraphicsDropShadowEffect>
+#include <QFile>
+#include <QFileInfo>
 #include <QImage>
 #include <QPainter>
 #include <QPixmap>
+#include <QPixmapCache>
+#include <QVector>
+#include <QtMath>
+
+OffAnonymous(const char* const c_cachePrefix = "qoffice:")
+#if defined(QOFFICE_ENABLE_PROFILER)
+OffAnonymous(int g_decodeCount = 0)
+#endif
 
 QImage OfficeImage::convertToGrayscale(const QImage& original)
 {
@@ -62,12 +71,184 @@ QPixmap OfficeImage::convertToGrayscale(const QPixmap& original)
     return QPixmap::fromImage(convertToGrayscale(original.toImage()));
 }
 
-QPixmap OfficeImage::generateDropShadow(const QSize& size)
+QPixmap OfficeImage::loadPixmap(const QString& path, qreal ratio)
+{
+    if (ratio <= 0.0)
+    {
+        ratio = 1.0;
+    }
+
+    // Widgets reload their pixmaps whenever they are moved to a screen with a
+    // different ratio, so each pixmap is only ever scaled once per ratio. All
+    // widgets share the same implicitly shared pixmap of the process cache.
+    const QString key = cacheKey(path + QLatin1Char('@') + QString::number(ratio));
+
+    QPixmap result;
+    if (QPixmapCache::find(key, &result))
+    {
+        return result;
+    }
+
+    OffProfileScope("OfficeImage::loadPixmap");
+
+    QSize logical;
+
+    const int scale = qCeil(ratio);
+    const QString variant = variantPath(path, scale);
+    if (scale > 1 && QFile::exists(variant))
+    {
+        // Hand-crafted variants are drawn for the next integral ratio and are
+        // only scaled down if the ratio is fractional, e.g. 1.5.
+        result = decodePixmap(variant);
+        logical = result.size() / scale;
+    }
+    else
+    {
+        result = decodePixmap(path);
+        logical = result.size();
+    }
+
+    if (result.isNull())
+    {
+        return result;
+    }
+
+    const QSize device = deviceSize(logical, ratio);
+    if (result.size() != device)
+    {
+        result = result.scaled(device, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    result.setDevicePixelRatio(ratio);
+    QPixmapCache::insert(key, result);
+
+    return result;
+}
+
+QSize OfficeImage::logicalSize(const QPixmap& pixmap)
 {
-    QPixmap result(size);
+    const qreal ratio = pixmap.devicePixelRatio();
+
+    return QSize(
+        qRound(pixmap.width()  / ratio),
+        qRound(pixmap.height() / ratio)
+        );
+}
+
+QSize OfficeImage::deviceSize(const QSize& size, qreal ratio)
+{
+    return QSize(
+        qRound(size.width()  * ratio),
+        qRound(size.height() * ratio)
+        );
+}
+
+QPixmap OfficeImage::captionGlyph(
+    CaptionGlyph glyph,
+    const QSize& size,
+    qreal ratio,
+    const QColor& color)
+{
+    if (ratio <= 0.0)
+    {
+        ratio = 1.0;
+    }
+
+    const QString key = cacheKey(QString("glyph:%1:%2x%3@%4:%5")
+        .arg(glyph)
+        .arg(size.width())
+        .arg(size.height())
+        .arg(ratio)
+        .arg(color.rgba(), 8, 16, QLatin1Char('0')));
+
+    QPixmap cached;
+    if (QPixmapCache::find(key, &cached))
+    {
+        return cached;
+    }
+
+    QPixmap result(deviceSize(size, ratio));
+    if (result.isNull())
+    {
+        return result;
+    }
+
+    result.setDevicePixelRatio(ratio);
     result.fill(Qt::transparent);
 
+    // All strokes are one device-independent pixel wide. The coordinates of
+    // straight strokes lie on pixel centers, so they are not smeared across
+    // two pixels, whereas the diagonal strokes of the cross are antialiased.
+    const qreal w = size.width();
+    const qreal h = size.height();
+    const qreal offset = qRound(qMin(w, h) / 5.0);
+
     QPainter painter(&result);
+    painter.setPen(QPen(color, 1.0, Qt::SolidLine, Qt::SquareCap, Qt::MiterJoin));
+    painter.setBrush(Qt::NoBrush);
+
+    switch (glyph)
+    {
+    case CloseGlyph:
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(color, 1.0, Qt::SolidLine, Qt::FlatCap));
+        painter.drawLine(QPointF(0, 0), QPointF(w, h));
+        painter.drawLine(QPointF(0, h), QPointF(w, 0));
+        break;
+
+    case MaximizeGlyph:
+        painter.drawRect(QRectF(0.5, 0.5, w - 1, h - 1));
+        break;
+
+    case RestoreGlyph:
+        // The front box is drawn in full, the box behind it only peeks out
+        // at the top and on the right.
+        painter.drawRect(QRectF(0.5, offset + 0.5, w - offset - 1, h - offset - 1));
+        painter.drawLine(QPointF(offset + 0.5, 0.5), QPointF(w - 0.5, 0.5));
+        painter.drawLine(QPointF(w - 0.5, 0.5), QPointF(w - 0.5, h - offset - 0.5));
+        break;
+
+    case MinimizeGlyph:
+        painter.drawLine(QPointF(0.5, h / 2 + 0.5), QPointF(w - 0.5, h / 2 + 0.5));
+        break;
+    }
+
+    painter.end();
+    QPixmapCache::insert(key, result);
+
+    return result;
+}
+
+QRect OfficeImage::centerRectangle(const QPixmap& pixmap, const QRect& area)
+{
+    const QSize size = logicalSize(pixmap);
+
+    int dx = (area.width()  - size.width())  / 2;
+    int dy = (area.height() - size.height()) / 2;
+
+    return QRect(area.x() + dx, area.y() + dy, size.width(), size.height());
+}
+
+QPixmap OfficeImage::generateDropShadow(const QSize& size, qreal ratio)
+{
+    return QPixmap::fromImage(generateDropShadowImage(size, ratio));
+}
+
+QImage OfficeImage::generateDropShadowImage(const QSize& size, qreal ratio)
+{
+    OffProfileScope("OfficeImage::generateDropShadowImage");
+
+    QImage result(deviceSize(size, ratio), QImage::Format_ARGB32_Premultiplied);
+    if (result.isNull())
+    {
+        return result;
+    }
+
+    // The painter works in device-independent pixels from now on, while the
+    // blur below operates on the device pixels directly.
+    result.setDevicePixelRatio(ratio);
+    result.fill(Qt::transparent);
+
     QPainterPath path;
     QRectF roundedRect(
         c_shadowPadding,
@@ -77,20 +258,133 @@ QPixmap OfficeImage::generateDropShadow(const QSize& size)
         );
 
     path.addRoundedRect(roundedRect, 4, 4);
-    painter.fillPath(path, Qt::black);
+    path.translate(c_shadowBlur, c_shadowBlur);
 
-    QGraphicsScene scene;
-    QGraphicsPixmapItem item(result);
-    QGraphicsDropShadowEffect shadow;
+    QPainter painter(&result);
+    painter.fillPath(path, Qt::black);
+    painter.end();
 
-    shadow.setBlurRadius(c_shadowPadding);
-    shadow.setOffset(c_shadowBlur, c_shadowBlur);
-    shadow.setColor(Qt::black);
+    // Three successive box blurs approximate the gaussian blur that the
+    // QGraphicsDropShadowEffect used to apply. Unlike the graphics effect,
+    // this only touches the QImage and can therefore run on any thread.
+    const int radius = qMax(1, qRound(c_shadowPadding / 3 * ratio));
+    for (int i = 0; i < 3; i++)
+    {
+        blurAlpha(result, radius);
+    }
 
-    item.setGraphicsEffect(&shadow);
-    scene.addItem(&item);
-    scene.render(&painter);
+    // The shape itself is drawn on top of its own shadow, just like the
+    // graphics effect rendered the source item on top of the blurred one.
+    painter.begin(&result);
+    painter.fillPath(path.translated(-c_shadowBlur, -c_shadowBlur), Qt::black);
     painter.end();
 
     return result;
 }
+
+QString OfficeImage::cacheKey(const QString& name)
+{
+    // Prefixed so that the entries never collide with the keys that the
+    // application or Qt itself store in the global QPixmapCache.
+    return QLatin1String(c_cachePrefix) + name;
+}
+
+QPixmap OfficeImage::decodePixmap(const QString& path)
+{
+    // The decoded file is cached on its own, so that a window moving to a
+    // screen with another ratio only scales the pixmap instead of decoding
+    // the file once again.
+    const QString key = cacheKey(QLatin1String("file:") + path);
+
+    QPixmap result;
+    if (QPixmapCache::find(key, &result))
+    {
+        return result;
+    }
+
+    Office::ensureResources();
+    if (result.load(path))
+    {
+        QPixmapCache::insert(key, result);
+
+#if defined(QOFFICE_ENABLE_PROFILER)
+        OffProfileCount("OfficeImage::decodeCount", ++g_decodeCount);
+#endif
+    }
+
+    return result;
+}
+
+QString OfficeImage::variantPath(const QString& path, int scale)
+{
+    // Follows the naming scheme of Qt, e.g. "close.png" becomes "close@2x.png".
+    const QFileInfo info(path);
+    const QString suffix = info.completeSuffix();
+    const QString base = suffix.isEmpty() ? path : path.left(path.size() - suffix.size() - 1);
+
+    QString result = base + QLatin1Char('@') + QString::number(scale) + QLatin1Char('x');
+    if (!suffix.isEmpty())
+    {
+        result += QLatin1Char('.') + suffix;
+    }
+
+    return result;
+}
+
+void OfficeImage::blurAlpha(QImage& image, int radius)
+{
+    const int imgWidth  = image.width();
+    const int imgHeight = image.height();
+    const int stride    = image.bytesPerLine() / 4;
+    const int window    = radius * 2 + 1;
+
+    QRgb* bits = reinterpret_cast<QRgb*>(image.bits());
+    QVector<int> line(qMax(imgWidth, imgHeight));
+
+    // The shadow is plain black, hence only the alpha channel is blurred. The
+    // pixels outside the image are treated as being fully transparent.
+    for (int y = 0; y < imgHeight; y++)
+    {
+        QRgb* scanLine = bits + y * stride;
+        for (int x = 0; x < imgWidth; x++)
+        {
+            line[x] = qAlpha(scanLine[x]);
+        }
+
+        int sum = 0;
+        for (int x = 0; x <= radius && x < imgWidth; x++)
+        {
+            sum += line[x];
+        }
+
+        for (int x = 0; x < imgWidth; x++)
+        {
+            scanLine[x] = qRgba(0, 0, 0, sum / window);
+
+            if (x + radius + 1 < imgWidth) sum += line[x + radius + 1];
+            if (x - radius >= 0)           sum -= line[x - radius];
+        }
+    }
+
+    for (int x = 0; x < imgWidth; x++)
+    {
+        for (int y = 0; y < imgHeight; y++)
+        {
+            line[y] = qAlpha(bits[y * stride + x]);
+        }
+
+        int sum = 0;
+        for (int y = 0; y <= radius && y < imgHeight; y++)
+        {
+            sum += line[y];
+        }
+
+        for (int y = 0; y < imgHeight; y++)
+        {
+            bits[y * stride + x] = qRgba(0, 0, 0, sum / window);
+
+            if (y + radius + 1 < imgHeight) sum += line[y + radius + 1];
+            if (y - radius >= 0)            sum -= line[y - radius];
+        }
+    }
+}
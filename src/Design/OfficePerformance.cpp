@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Design module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficePerformance.hpp>
+
+#include <QAtomicInt>
+#include <QByteArray>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_unknownProfile = -1)
+OffAnonymous(const char* const c_profileVariable = "QOFFICE_PERFORMANCE_PROFILE")
+OffAnonymous(QAtomicInt g_profile(c_unknownProfile))
+
+OfficePerformance::Profile OfficePerformance::profile()
+{
+    int value = g_profile.loadAcquire();
+    if (value == c_unknownProfile)
+    {
+        // The environment is only consulted once. A profile selected through
+        // the API before that wins the race and is kept.
+        const QByteArray variable = qgetenv(c_profileVariable).toLower();
+        const int parsed = (variable == "remote") ? RemoteProfile : DefaultProfile;
+
+        g_profile.testAndSetOrdered(c_unknownProfile, parsed);
+        value = g_profile.loadAcquire();
+    }
+
+    return static_cast<Profile>(value);
+}
+
+void OfficePerformance::setProfile(Profile profile)
+{
+    g_profile.storeRelease(profile);
+}
+
+bool OfficePerformance::isTranslucencyEnabled()
+{
+    return profile() == DefaultProfile;
+}
+
+bool OfficePerformance::isAnimationEnabled()
+{
+    return profile() == DefaultProfile;
+}
+
+bool OfficePerformance::isHoverEnabled()
+{
+    return profile() == DefaultProfile;
+}
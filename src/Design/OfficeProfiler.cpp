@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Design module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficeProfiler.hpp>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+OffAnonymous(QOFFICE_CONSTEXPR uint c_bufferSize = 1 << 13)
+
+namespace
+{
+struct ProfilerEvent
+{
+    const char* name;
+    char        phase;
+    qint64      start;
+    qint64      value;
+};
+
+struct ProfilerBuffer
+{
+    ProfilerEvent        events[c_bufferSize];
+    QAtomicInteger<uint> head;
+    int                  thread;
+};
+}
+
+OffAnonymous(QAtomicInt g_enabled(0))
+OffAnonymous(QAtomicInteger<qint64> g_clearTime(0))
+OffAnonymous(QMutex g_registryMutex)
+OffAnonymous(QVector<ProfilerBuffer*> g_registry)
+OffAnonymous(thread_local ProfilerBuffer* t_buffer = nullptr)
+
+namespace
+{
+ProfilerBuffer* threadBuffer()
+{
+    if (t_buffer == nullptr)
+    {
+        // Buffers are registered once per thread and stay alive until the
+        // process exits, so the export never reads a destroyed buffer.
+        t_buffer = new ProfilerBuffer;
+        t_buffer->head.storeRelease(0);
+
+        QMutexLocker locker(&g_registryMutex);
+        t_buffer->thread = g_registry.size() + 1;
+        g_registry.append(t_buffer);
+    }
+
+    return t_buffer;
+}
+
+void appendEscaped(QByteArray& json, const char* str)
+{
+    for (; *str != '\0'; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+        {
+            json.append('\\');
+        }
+
+        json.append(*str);
+    }
+}
+}
+
+OfficeProfiler::Scope::Scope(const char* name)
+    : m_name(name)
+    , m_start(isEnabled() ? timestamp() : -1)
+{
+}
+
+OfficeProfiler::Scope::~Scope()
+{
+    if (m_start != -1)
+    {
+        record(m_name, 'X', m_start, timestamp() - m_start);
+    }
+}
+
+void OfficeProfiler::setEnabled(bool enabled)
+{
+    g_enabled.storeRelease(enabled ? 1 : 0);
+}
+
+bool OfficeProfiler::isEnabled()
+{
+    return g_enabled.loadAcquire() != 0;
+}
+
+void OfficeProfiler::count(const char* name, qint64 value)
+{
+    if (isEnabled())
+    {
+        record(name, 'C', timestamp(), value);
+    }
+}
+
+void OfficeProfiler::clear()
+{
+    // Buffers of other threads can not be reset without locking, so events
+    // recorded before this point in time are ignored by the export instead.
+    g_clearTime.storeRelease(timestamp());
+}
+
+QByteArray OfficeProfiler::exportChromeTrace()
+{
+    QVector<ProfilerBuffer*> buffers;
+    {
+        QMutexLocker locker(&g_registryMutex);
+        buffers = g_registry;
+    }
+
+    const qint64 clearTime = g_clearTime.loadAcquire();
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QByteArray json("{\"traceEvents\":[");
+    bool first = true;
+
+    for (ProfilerBuffer* buffer : buffers)
+    {
+        const uint head = buffer->head.loadAcquire();
+        const uint tail = (head > c_bufferSize) ? head - c_bufferSize : 0;
+
+        QVector<ProfilerEvent> events;
+        events.reserve(static_cast<int>(head - tail));
+        for (uint i = tail; i < head; ++i)
+        {
+            events.append(buffer->events[i % c_bufferSize]);
+        }
+
+        // The owning thread keeps writing while the events are copied. Every
+        // event that might have been overwritten in the meantime is dropped,
+        // including the slot of newHead, which may be written right now.
+        const uint newHead = buffer->head.loadAcquire();
+        const uint valid = (newHead + 1 > c_bufferSize)
+            ? newHead + 1 - c_bufferSize
+            : 0;
+
+        for (uint i = tail; i < head; ++i)
+        {
+            const ProfilerEvent& event = events.at(static_cast<int>(i - tail));
+            if (i < valid || event.start < clearTime)
+            {
+                continue;
+            }
+
+            if (!first)
+            {
+                json.append(',');
+            }
+
+            first = false;
+            json.append("{\"name\":\"");
+            appendEscaped(json, event.name);
+            json.append("\",\"ph\":\"");
+            json.append(event.phase);
+            json.append("\",\"ts\":");
+            json.append(QByteArray::number(event.start / 1000.0, 'f', 3));
+
+            if (event.phase == 'X')
+            {
+                json.append(",\"dur\":");
+                json.append(QByteArray::number(event.value / 1000.0, 'f', 3));
+            }
+            else
+            {
+                json.append(",\"args\":{\"value\":");
+                json.append(QByteArray::number(event.value));
+                json.append('}');
+            }
+
+            json.append(",\"pid\":");
+            json.append(QByteArray::number(pid));
+            json.append(",\"tid\":");
+            json.append(QByteArray::number(buffer->thread));
+            json.append('}');
+        }
+    }
+
+    json.append("]}");
+    return json;
+}
+
+bool OfficeProfiler::saveChromeTrace(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+    {
+        return false;
+    }
+
+    return file.write(exportChromeTrace()) != -1;
+}
+
+qint64 OfficeProfiler::timestamp()
+{
+    // The initialization of static locals is thread-safe since C++11.
+    static const QElapsedTimer timer = []()
+    {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        return elapsed;
+    }();
+
+    return timer.nsecsElapsed();
+}
+
+void OfficeProfiler::record(const char* name, char phase, qint64 start, qint64 value)
+{
+    ProfilerBuffer* buffer = threadBuffer();
+    const uint head = buffer->head.loadAcquire();
+
+    ProfilerEvent& event = buffer->events[head % c_bufferSize];
+    event.name  = name;
+    event.phase = phase;
+    event.start = start;
+    event.value = value;
+
+    // Publishes the event. Only this thread ever writes to the buffer.
+    buffer->head.storeRelease(head + 1);
+}
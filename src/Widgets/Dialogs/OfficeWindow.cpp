@@ -23,46 +23,67 @@
 #include <QOffice/Design/OfficeAccent.hpp>
 #include <QOffice/Design/OfficeImage.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
 #include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
 
+#include <QDataStream>
 #include <QLayout>
 #include <QPainter>
+#include <QtConcurrent>
 #include <QtEvents>
+#include <QWindow>
 
 OffAnonymous(OfficeWindow* g_activeWindow = nullptr)
 OffAnonymous(QOFFICE_CONSTEXPR int c_titleHeight = 28)
 
+OffAnonymous(QOFFICE_CONSTEXPR int c_resizeBorder = 10)
+OffAnonymous(QOFFICE_CONSTEXPR int c_resizeGrip = 4)
+OffAnonymous(QOFFICE_CONSTEXPR quint32 c_stateMagic = 0x514F5753) // "QOWS"
+OffAnonymous(QOFFICE_CONSTEXPR quint16 c_stateVersion = 1)
+
 OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_topLeft = OfficeWindow::ResizeTop | OfficeWindow::ResizeLeft)
 OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_topRight = OfficeWindow::ResizeTop | OfficeWindow::ResizeRight)
 OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_bottomLeft = OfficeWindow::ResizeBottom | OfficeWindow::ResizeLeft)
 OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_bottomRight = OfficeWindow::ResizeBottom | OfficeWindow::ResizeRight)
-OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_top = OfficeWindow::ResizeTop)
-OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_left = OfficeWindow::ResizeLeft)
-OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_bottom = OfficeWindow::ResizeBottom)
-OffAnonymous(QOFFICE_CONSTEXPR OfficeWindow::ResizeDirection c_right = OfficeWindow::ResizeRight)
 
 OfficeWindow::OfficeWindow(QWidget* parent)
     : QWidget(parent)
-    , m_resizeTopLeft(new priv::ResizeArea(this, c_topLeft))
-    , m_resizeTopRight(new priv::ResizeArea(this, c_topRight))
-    , m_resizeBottomLeft(new priv::ResizeArea(this, c_bottomLeft))
-    , m_resizeBottomRight(new priv::ResizeArea(this, c_bottomRight))
-    , m_resizeTop(new priv::ResizeArea(this, c_top))
-    , m_resizeLeft(new priv::ResizeArea(this, c_left))
-    , m_resizeBottom(new priv::ResizeArea(this, c_bottom))
-    , m_resizeRight(new priv::ResizeArea(this, c_right))
     , m_titleBar(new priv::Titlebar(this))
     , m_stateWindow(StateNone)
+    , m_resizeDirection(ResizeNone)
+    , m_resizeCursor(Qt::ArrowCursor)
     , m_flagsWindow(NoFlag)
     , m_tooltipVisible(false)
+    , m_debugOverlay(nullptr)
+    , m_shadowWatcher(new QFutureWatcher<QImage>(this))
+    , m_shadowGeneration(new QAtomicInt(0))
 {
     setGeometry(x(), y(), 600, 400);
     setFocusPolicy(Qt::ClickFocus);
     setMouseTracking(true);
 
-    // Create a frameless window with a translucent background for the shadow.
+    // Hover events are propagated to the parent widgets, which allows to reset
+    // the resize cursor once the mouse pointer moves on to a child widget.
+    setAttribute(Qt::WA_Hover);
+
+    // Create a frameless window with a translucent background for the shadow,
+    // unless the performance profile asks for an opaque surface.
     setWindowFlags(Qt::Window | Qt::FramelessWindowHint | Qt::WindowMinimizeButtonHint);
-    setAttribute(Qt::WA_TranslucentBackground);
+    updateTranslucency();
+
+    QObject::connect(
+        m_shadowWatcher,
+        &QFutureWatcher<QImage>::finished,
+        this,
+        &OfficeWindow::dropShadowGenerated
+        );
+
+    if (qEnvironmentVariableIsSet("QOFFICE_DEBUG_OVERLAY"))
+    {
+        setDebugOverlayEnabled(true);
+    }
 }
 
 bool OfficeWindow::hasCloseButton() const
@@ -179,6 +200,90 @@ void OfficeWindow::setResizable(bool resizable)
 void OfficeWindow::setFlags(Flags flags)
 {
     m_flagsWindow = flags;
+
+    updateTranslucency();
+    updateResizeRectangles();
+    updateLayoutPadding();
+}
+
+void OfficeWindow::setDebugOverlayEnabled(bool enabled)
+{
+    if (enabled && m_debugOverlay == nullptr)
+    {
+        m_debugOverlay = new priv::DebugOverlay(this);
+    }
+    else if (!enabled && m_debugOverlay != nullptr)
+    {
+        delete m_debugOverlay;
+        m_debugOverlay = nullptr;
+    }
+}
+
+QByteArray OfficeWindow::saveState() const
+{
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // The normal geometry is saved even when maximized, so that restoring the
+    // window afterwards brings it back to where the user left it.
+    const QRect geometry = isMaximized() ? normalGeometry() : this->geometry();
+    stream << c_stateMagic << c_stateVersion << geometry << isMaximized();
+
+    QList<QByteArray> menus;
+    for (auto* menu : findChildren<OfficeMenu*>())
+    {
+        menus.append(menu->saveState());
+    }
+
+    stream << menus;
+
+    return state;
+}
+
+bool OfficeWindow::restoreState(const QByteArray& state)
+{
+    QDataStream stream(state);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    QRect geometry;
+    bool maximized = false;
+    QList<QByteArray> menus;
+
+    stream >> magic >> version;
+    if (magic != c_stateMagic || version != c_stateVersion)
+    {
+        return false;
+    }
+
+    stream >> geometry >> maximized >> menus;
+    if (stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    // The geometry is applied first, it becomes the normal geometry of the
+    // window once it is maximized. Neither call shows the window.
+    setWindowState(windowState() & ~Qt::WindowMaximized);
+    if (geometry.isValid())
+    {
+        setGeometry(geometry);
+    }
+
+    if (maximized)
+    {
+        setWindowState(windowState() | Qt::WindowMaximized);
+    }
+
+    const QList<OfficeMenu*> children = findChildren<OfficeMenu*>();
+    for (int i = 0; i < children.size() && i < menus.size(); ++i)
+    {
+        children.at(i)->restoreState(menus.at(i));
+    }
+
+    return true;
 }
 
 OfficeWindow* OfficeWindow::activeWindow()
@@ -193,6 +298,8 @@ void OfficeWindow::accentUpdateEvent()
 
 void OfficeWindow::paintEvent(QPaintEvent*)
 {
+    OffProfileScope("OfficeWindow::paintEvent");
+
     QPainter painter(this);
 
     // Retrieves various standardized QOffice colors.
@@ -201,9 +308,11 @@ void OfficeWindow::paintEvent(QPaintEvent*)
     const QColor& colorAccent = OfficeAccent::color(accent());
 
     // Drop shadow
-    if (m_stateWindow != StateResize && isActive() && !isMaximized())
+    if (m_stateWindow != StateResize && isActive() && shadowPadding() != 0)
     {
-        painter.drawPixmap(QPoint(), m_dropShadow);
+        // While the shadow for the current size is still being generated in
+        // the background, the previous shadow is stretched to fit the window.
+        painter.drawPixmap(rect(), m_dropShadow);
     }
 
     // Background
@@ -224,22 +333,22 @@ void OfficeWindow::paintEvent(QPaintEvent*)
 
 void OfficeWindow::resizeEvent(QResizeEvent* event)
 {
+    OffProfileScope("OfficeWindow::resizeEvent");
+
     updateResizeRectangles();
     updateLayoutPadding();
-    updateResizeWidgets();
 
     // Does not generate a drop shadow if resizing or currently being in
     // maximized window mode.
-    if (m_stateWindow != StateResize && !isMaximized())
+    if (m_stateWindow != StateResize && shadowPadding() != 0)
     {
-        // Little hack: When the window is really big, repainting the drop
-        // shadow takes long, causing layouts, button rectangles and other
-        // contents to be redrawn late, causing a visual glitch.
-        repaint();
-
+        // The shadow is generated in the background and does not hold up the
+        // repaint of the resized window anymore, see dropShadowGenerated.
         generateDropShadow();
     }
 
+    // Resizing invalidates the whole window anyway. The update is coalesced
+    // with it into a single repaint instead of painting synchronously.
     update();
 
     QWidget::resizeEvent(event);
@@ -272,11 +381,77 @@ void OfficeWindow::showEvent(QShowEvent* event)
     updateLayoutPadding();
     updateResizeRectangles();
 
+    // The native window is only created now and recreated whenever the
+    // translucency changes, hence the connection is checked on every show.
+    if (windowHandle() != nullptr)
+    {
+        QObject::connect(
+            windowHandle(),
+            &QWindow::screenChanged,
+            this,
+            &OfficeWindow::screenChanged,
+            Qt::UniqueConnection
+            );
+    }
+
     QWidget::showEvent(event);
 }
 
+void OfficeWindow::mouseMoveEvent(QMouseEvent* event)
+{
+    if (m_stateWindow == StateResize)
+    {
+        resizeTo(event->globalPos());
+    }
+
+    QWidget::mouseMoveEvent(event);
+}
+
+void OfficeWindow::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton)
+    {
+        const ResizeDirection direction = resizeDirectionAt(event->pos());
+        if (direction != ResizeNone && !startSystemResize(direction))
+        {
+            m_stateWindow = StateResize;
+            m_resizeDirection = direction;
+            updateResizeCursor(direction);
+        }
+    }
+
+    QWidget::mousePressEvent(event);
+}
+
+void OfficeWindow::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton && m_stateWindow == StateResize)
+    {
+        m_stateWindow = StateNone;
+        m_resizeDirection = ResizeNone;
+        updateResizeCursor(resizeDirectionAt(event->pos()));
+        generateDropShadow();
+        update();
+    }
+
+    QWidget::mouseReleaseEvent(event);
+}
+
 bool OfficeWindow::event(QEvent* event)
 {
+    if (m_debugOverlay != nullptr && event->type() == QEvent::UpdateRequest)
+    {
+        // The window and all of its children are painted while processing the
+        // update request, which therefore corresponds to one frame.
+        QElapsedTimer timer;
+        timer.start();
+
+        const bool result = QWidget::event(event);
+        m_debugOverlay->addFrame(timer.nsecsElapsed());
+
+        return result;
+    }
+
     switch (event->type())
     {
     case QEvent::WindowActivate:
@@ -286,29 +461,101 @@ bool OfficeWindow::event(QEvent* event)
     case QEvent::WindowDeactivate:
         focusOutEvent(nullptr);
         break;
+
+    case QEvent::HoverMove:
+        // Hover moves arrive for the child widgets as well. The cursor is only
+        // changed if the mouse pointer crosses the border of a resize zone.
+        if (m_stateWindow != StateResize)
+        {
+            auto* hoverEvent = static_cast<QHoverEvent*>(event);
+            updateResizeCursor(resizeDirectionAt(hoverEvent->pos()));
+        }
+        return true;
+
+    case QEvent::HoverEnter:
+    case QEvent::HoverLeave:
+        // QWidget repaints the entire window on these events when WA_Hover is
+        // set, which is not needed at all, since the window has no hover look.
+        if (m_stateWindow != StateResize)
+        {
+            updateResizeCursor(ResizeNone);
+        }
+        return true;
+
+    default:
+        break;
     }
 
     return QWidget::event(event);
 }
 
+void OfficeWindow::dropShadowGenerated()
+{
+    const QImage shadow = m_shadowWatcher->result();
+
+    // Skipped jobs yield a null image. Results for a size or screen other than
+    // the current one are discarded, since a newer job is on its way anyway.
+    const qreal ratio = devicePixelRatioF();
+    if (!shadow.isNull() &&
+        shadow.devicePixelRatio() == ratio &&
+        shadow.size() == OfficeImage::deviceSize(size(), ratio))
+    {
+        m_dropShadow = QPixmap::fromImage(shadow);
+        update();
+    }
+}
+
+void OfficeWindow::screenChanged()
+{
+    // The shadow is rendered in device pixels, thus needs to be regenerated
+    // if the new screen has a different device pixel ratio than the old one.
+    if (m_stateWindow != StateResize &&
+        shadowPadding() != 0 &&
+        m_dropShadow.devicePixelRatio() != devicePixelRatioF())
+    {
+        generateDropShadow();
+    }
+
+    update();
+}
+
 void OfficeWindow::generateDropShadow()
 {
-    m_dropShadow = OfficeImage::generateDropShadow(size());
+    const QSize shadowSize = size();
+    const qreal shadowRatio = devicePixelRatioF();
+
+    // E.g. releasing the mouse after resizing back to the original size. Any
+    // pending job is for another size and will be discarded on arrival.
+    if (m_dropShadow.devicePixelRatio() == shadowRatio &&
+        m_dropShadow.size() == OfficeImage::deviceSize(shadowSize, shadowRatio))
+    {
+        return;
+    }
+
+    const QSharedPointer<QAtomicInt> generation = m_shadowGeneration;
+    const int ticket = generation->fetchAndAddOrdered(1) + 1;
+
+    // Blurring the shadow of a big window takes a while, therefore it is done
+    // on a worker thread. Jobs that did not start before a newer size arrived
+    // are skipped, and replacing the future drops results of running ones.
+    m_shadowWatcher->setFuture(QtConcurrent::run([generation, ticket, shadowSize, shadowRatio]() -> QImage
+        {
+            if (generation->loadAcquire() != ticket)
+            {
+                return QImage();
+            }
+
+            return OfficeImage::generateDropShadowImage(shadowSize, shadowRatio);
+        }));
 }
 
 void OfficeWindow::updateResizeRectangles()
 {
-    int padding  = (isMaximized()) ? 0 : c_shadowPadding;
+    const int padding = shadowPadding();
 
-    // Resize areas
-    m_resizeTopLeft->setGeometry(0, 0, 10, 10);
-    m_resizeTopRight->setGeometry(width() - 10, 0, 10, 10);
-    m_resizeBottomRight->setGeometry(width() - 10, height() - 10, 10, 10);
-    m_resizeBottomLeft->setGeometry(0, height() - 10, 10, 10);
-    m_resizeTop->setGeometry(10, 0, width() - 20, 10);
-    m_resizeRight->setGeometry(width() - 10, 10, 10, height() - 20);
-    m_resizeBottom->setGeometry(10, height() - 10, width() - 20, 10);
-    m_resizeLeft->setGeometry(0, 10, 10, height() - 20);
+    // Without a drop shadow, the window paints every single pixel, so there is
+    // no need for Qt to prepare the background beforehand.
+    setAttribute(Qt::WA_OpaquePaintEvent, padding == 0);
 
     m_clientRectangle.setRect(
         padding,
@@ -317,10 +564,15 @@ void OfficeWindow::updateResizeRectangles()
         height() - padding * 2
         );
 
+    // Without a drop shadow, the titlebar keeps clear of the grip, so that the
+    // top edge can be grabbed for resizing as well.
+    const bool hasGrip = !hasShadow() && !isMaximized();
+    const int inset = hasGrip ? c_resizeGrip : padding + 1;
+
     m_titleBar->setGeometry(
-        padding + 1,
-        padding + 1,
-        width() - padding * 2 - 2,
+        inset,
+        inset,
+        width() - inset * 2,
         c_titleHeight - 1
         );
 
@@ -328,30 +580,133 @@ void OfficeWindow::updateResizeRectangles()
     m_titleBar->updateVisibleTitle();
 }
 
-void OfficeWindow::updateResizeWidgets()
+void OfficeWindow::updateResizeCursor(ResizeDirection direction)
 {
-    if (OffHasFlag(m_flagsWindow, NoResize) || isMaximized())
+    Qt::CursorShape shape = Qt::ArrowCursor;
+    if (direction == c_topLeft || direction == c_bottomRight)
     {
-        if (m_resizeTopLeft->isVisible()) m_resizeTopLeft->hide();
-        if (m_resizeTopRight->isVisible()) m_resizeTopRight->hide();
-        if (m_resizeBottomRight->isVisible()) m_resizeBottomRight->hide();
-        if (m_resizeBottomLeft->isVisible()) m_resizeBottomLeft->hide();
-        if (m_resizeTop->isVisible()) m_resizeTop->hide();
-        if (m_resizeLeft->isVisible()) m_resizeLeft->hide();
-        if (m_resizeBottom->isVisible()) m_resizeBottom->hide();
-        if (m_resizeRight->isVisible()) m_resizeRight->hide();
+        shape = Qt::SizeFDiagCursor;
     }
-    else
+    else if (direction == c_topRight || direction == c_bottomLeft)
+    {
+        shape = Qt::SizeBDiagCursor;
+    }
+    else if (direction == ResizeLeft || direction == ResizeRight)
     {
-        if (!m_resizeTopLeft->isVisible()) m_resizeTopLeft->show();
-        if (!m_resizeTopRight->isVisible()) m_resizeTopRight->show();
-        if (!m_resizeBottomRight->isVisible()) m_resizeBottomRight->show();
-        if (!m_resizeBottomLeft->isVisible()) m_resizeBottomLeft->show();
-        if (!m_resizeTop->isVisible()) m_resizeTop->show();
-        if (!m_resizeLeft->isVisible()) m_resizeLeft->show();
-        if (!m_resizeBottom->isVisible()) m_resizeBottom->show();
-        if (!m_resizeRight->isVisible()) m_resizeRight->show();
+        shape = Qt::SizeHorCursor;
     }
+    else if (direction == ResizeTop || direction == ResizeBottom)
+    {
+        shape = Qt::SizeVerCursor;
+    }
+
+    // Changing the cursor is comparatively expensive and affects all children
+    // that do not have a cursor on their own, hence the cached shape.
+    if (shape != m_resizeCursor)
+    {
+        m_resizeCursor = shape;
+        if (shape == Qt::ArrowCursor)
+        {
+            unsetCursor();
+        }
+        else
+        {
+            setCursor(shape);
+        }
+    }
+}
+
+void OfficeWindow::resizeTo(const QPoint& posGlobal)
+{
+    QRect windowRect = geometry();
+    QRect originRect = geometry();
+    QSize minSize    = minimumSize();
+    QSize maxSize    = maximumSize();
+
+    if (OffHasFlag(m_resizeDirection, ResizeLeft))
+        windowRect.setLeft(posGlobal.x());
+    if (OffHasFlag(m_resizeDirection, ResizeRight))
+        windowRect.setRight(posGlobal.x());
+    if (OffHasFlag(m_resizeDirection, ResizeBottom))
+        windowRect.setBottom(posGlobal.y());
+    if (OffHasFlag(m_resizeDirection, ResizeTop))
+        windowRect.setTop(posGlobal.y());
+
+    // If we by any chance are about to exceed the maximum or minimum size,
+    // we have to reset the geometry in one or another direction.
+    if (windowRect.width() < minSize.width() ||
+        windowRect.width() > maxSize.width())
+    {
+        windowRect.setLeft(originRect.left());
+        windowRect.setRight(originRect.right());
+    }
+
+    if (windowRect.height() < minSize.height() ||
+        windowRect.height() > maxSize.height())
+    {
+        windowRect.setTop(originRect.top());
+        windowRect.setBottom(originRect.bottom());
+    }
+
+    setGeometry(windowRect);
+}
+
+bool OfficeWindow::startSystemMove()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    if (OffHasFlag(m_flagsWindow, SystemMoveResize) && windowHandle() != nullptr)
+    {
+        return windowHandle()->startSystemMove();
+    }
+#endif
+
+    return false;
+}
+
+bool OfficeWindow::startSystemResize(ResizeDirection direction)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    if (OffHasFlag(m_flagsWindow, SystemMoveResize) && windowHandle() != nullptr)
+    {
+        Qt::Edges edges;
+        if (OffHasFlag(direction, ResizeLeft))   edges |= Qt::LeftEdge;
+        if (OffHasFlag(direction, ResizeTop))    edges |= Qt::TopEdge;
+        if (OffHasFlag(direction, ResizeRight))  edges |= Qt::RightEdge;
+        if (OffHasFlag(direction, ResizeBottom)) edges |= Qt::BottomEdge;
+
+        // The window system takes over the mouse grab. Since the window never
+        // enters StateResize, every resize step regenerates the drop shadow.
+        return windowHandle()->startSystemResize(edges);
+    }
+#else
+    Q_UNUSED(direction)
+#endif
+
+    return false;
+}
+
+OfficeWindow::ResizeDirection OfficeWindow::resizeDirectionAt(const QPoint& pos) const
+{
+    if (OffHasFlag(m_flagsWindow, NoResize) || isMaximized())
+    {
+        return ResizeNone;
+    }
+
+    // The resize zones lie within the drop shadow, along the window edges.
+    // Without a shadow, only the grip around the contents is left to grab.
+    const int border = hasShadow() ? c_resizeBorder : c_resizeGrip;
+
+    ResizeDirection direction = ResizeNone;
+    if (pos.x() < border)
+        direction |= ResizeLeft;
+    else if (pos.x() >= width() - border)
+        direction |= ResizeRight;
+    if (pos.y() < border)
+        direction |= ResizeTop;
+    else if (pos.y() >= height() - border)
+        direction |= ResizeBottom;
+
+    return direction;
 }
 
 void OfficeWindow::updateLayoutPadding()
@@ -363,6 +718,16 @@ void OfficeWindow::updateLayoutPadding()
             // No drop shadow in maximize mode.
             layout()->setContentsMargins(1, c_titleHeight, 1, 1);
         }
+        else if (!hasShadow())
+        {
+            // Leaves a small grip around the contents to resize the window.
+            layout()->setContentsMargins(
+                c_resizeGrip,
+                c_titleHeight + c_resizeGrip - 1,
+                c_resizeGrip,
+                c_resizeGrip
+                );
+        }
         else
         {
             layout()->setContentsMargins(
@@ -375,7 +740,55 @@ void OfficeWindow::updateLayoutPadding()
     }
 }
 
+void OfficeWindow::updateTranslucency()
+{
+    const bool translucent = hasShadow();
+    if (testAttribute(Qt::WA_TranslucentBackground) == translucent)
+    {
+        return;
+    }
+
+    setAttribute(Qt::WA_TranslucentBackground, translucent);
+    setAttribute(Qt::WA_NoSystemBackground, translucent);
+
+    // The surface format is chosen when creating the native window, therefore
+    // an existing one has to be recreated, which setWindowFlags takes care of.
+    if (testAttribute(Qt::WA_WState_Created))
+    {
+        const bool visible = isVisible();
+        setWindowFlags(windowFlags());
+
+        if (visible)
+        {
+            show();
+        }
+    }
+}
+
+bool OfficeWindow::hasShadow() const
+{
+    // The remote profile takes the same path as the NoShadow flag, including
+    // the smaller resize zones.
+    return OffHasNotFlag(m_flagsWindow, NoShadow) &&
+           OfficePerformance::isTranslucencyEnabled();
+}
+
+int OfficeWindow::shadowPadding() const
+{
+    if (isMaximized() || !hasShadow())
+    {
+        return 0;
+    }
+
+    return c_shadowPadding;
+}
+
 bool OfficeWindow::isActive() const
 {
     return isActiveWindow() || m_tooltipVisible;
 }
+
+bool OfficeWindow::isDebugOverlayEnabled() const
+{
+    return m_debugOverlay != nullptr;
+}
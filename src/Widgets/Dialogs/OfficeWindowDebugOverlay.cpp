@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QOffice/Design/OfficeFont.hpp>
+#include <QOffice/Design/OfficeImage.hpp>
+#include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
+#include <QOffice/Widgets/Dialogs/OfficeWindowDebugOverlay.hpp>
+
+#include <QApplication>
+#include <QPainter>
+#include <QtEvents>
+#include <algorithm>
+#include <typeinfo>
+
+#if defined(Q_CC_GNU) || defined(Q_CC_CLANG)
+    #include <cxxabi.h>
+    #include <cstdlib>
+#endif
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_refreshInterval = 100)
+OffAnonymous(QOFFICE_CONSTEXPR int c_maximumClasses = 8)
+OffAnonymous(QOFFICE_CONSTEXPR int c_maximumFlashes = 256)
+OffAnonymous(QOFFICE_CONSTEXPR int c_hudPadding = 6)
+OffAnonymous(QOFFICE_CONSTEXPR qint64 c_flashDuration = 300)
+OffAnonymous(QOFFICE_CONSTEXPR qint64 c_statisticsInterval = 1000)
+
+priv::DebugOverlay::DebugOverlay(OfficeWindow* window)
+    : QWidget(window,
+              Qt::Tool |
+              Qt::FramelessWindowHint |
+              Qt::WindowStaysOnTopHint |
+              Qt::WindowTransparentForInput |
+              Qt::WindowDoesNotAcceptFocus)
+    , m_window(window)
+    , m_lastRotation(0)
+    , m_frameLast(0)
+    , m_frameMax(0)
+    , m_frameSum(0)
+    , m_frameCount(0)
+    , m_frameAverage(0.0)
+    , m_frameWorst(0)
+    , m_framesPerSecond(0)
+{
+    // The overlay is a window of its own. As a child widget, it would cause
+    // the very window it measures to be repainted on every refresh.
+    setAttribute(Qt::WA_TranslucentBackground);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_ShowWithoutActivating);
+    setFont(OfficeFont::font(OfficeFont::TypeWriter, OfficeFont::Small));
+
+    // Paint events are not propagated to parent widgets, therefore all events
+    // of the application are inspected for the ones targeting this window.
+    qApp->installEventFilter(this);
+
+    m_clock.start();
+    m_timerId = startTimer(c_refreshInterval);
+
+    syncGeometry();
+}
+
+priv::DebugOverlay::~DebugOverlay()
+{
+    if (qApp != nullptr)
+    {
+        qApp->removeEventFilter(this);
+    }
+}
+
+void priv::DebugOverlay::addFrame(qint64 nsecs)
+{
+    m_frameLast = nsecs;
+    m_frameMax = qMax(m_frameMax, nsecs);
+    m_frameSum += nsecs;
+    m_frameCount++;
+}
+
+bool priv::DebugOverlay::eventFilter(QObject* object, QEvent* event)
+{
+    switch (event->type())
+    {
+    case QEvent::Paint:
+        if (object->isWidgetType() && object != this)
+        {
+            auto* widget = static_cast<QWidget*>(object);
+            if (widget->window() == m_window)
+            {
+                recordPaint(widget, static_cast<QPaintEvent*>(event)->rect());
+            }
+        }
+        break;
+
+    case QEvent::Move:
+    case QEvent::Resize:
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+        if (object == m_window)
+        {
+            syncGeometry();
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+void priv::DebugOverlay::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    const qint64 now = m_clock.elapsed();
+
+    // Dirty regions fade out over time.
+    for (const Flash& flash : m_flashes)
+    {
+        const qreal fade = 1.0 - qreal(now - flash.time) / c_flashDuration;
+        painter.fillRect(flash.rect, QColor(255, 0, 0, qBound(0, int(60 * fade), 255)));
+        painter.setPen(QColor(255, 0, 0, qBound(0, int(200 * fade), 255)));
+        painter.drawRect(flash.rect.adjusted(0, 0, -1, -1));
+    }
+
+    QStringList lines;
+    lines << QString("frame %1 ms").arg(m_frameLast / 1e6, 0, 'f', 2);
+    lines << QString("avg %1 ms, max %2 ms, %3 fps")
+             .arg(m_frameAverage, 0, 'f', 2)
+             .arg(m_frameWorst / 1e6, 0, 'f', 2)
+             .arg(m_framesPerSecond);
+
+    for (const auto& entry : m_lastCounts)
+    {
+        lines << QString("%1 %2/s").arg(entry.first).arg(entry.second);
+    }
+
+    // Draws the statistics below the titlebar.
+    const QFontMetrics metrics(font());
+    const int lineHeight = metrics.height();
+
+    int boxWidth = 0;
+    for (const QString& line : lines)
+    {
+        boxWidth = qMax(boxWidth, metrics.width(line));
+    }
+
+    const int padding = m_window->shadowPadding();
+    const QRect box(
+        padding + c_hudPadding,
+        padding + c_hudPadding + 30,
+        boxWidth + c_hudPadding * 2,
+        lineHeight * lines.size() + c_hudPadding * 2
+        );
+
+    painter.fillRect(box, QColor(0, 0, 0, 190));
+    painter.setPen(Qt::white);
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        painter.drawText(
+            box.x() + c_hudPadding,
+            box.y() + c_hudPadding + lineHeight * i + metrics.ascent(),
+            lines.at(i)
+            );
+    }
+}
+
+void priv::DebugOverlay::timerEvent(QTimerEvent* event)
+{
+    if (event->timerId() != m_timerId)
+    {
+        QWidget::timerEvent(event);
+        return;
+    }
+
+    const qint64 now = m_clock.elapsed();
+    if (now - m_lastRotation >= c_statisticsInterval)
+    {
+        rotateStatistics();
+        m_lastRotation = now;
+    }
+
+    // Discards all flashes that have faded out already.
+    auto expired = std::remove_if(m_flashes.begin(), m_flashes.end(),
+        [now](const Flash& flash) { return now - flash.time >= c_flashDuration; });
+
+    m_flashes.erase(expired, m_flashes.end());
+
+    update();
+}
+
+void priv::DebugOverlay::recordPaint(QWidget* widget, const QRect& rect)
+{
+    m_paintCounts[className(widget)]++;
+
+    if (m_flashes.size() < c_maximumFlashes)
+    {
+        const QPoint topLeft = widget->mapTo(m_window, rect.topLeft());
+        m_flashes.append({ QRect(topLeft, rect.size()), m_clock.elapsed() });
+    }
+}
+
+void priv::DebugOverlay::syncGeometry()
+{
+    if (m_window->isVisible() && !m_window->isMinimized())
+    {
+        setGeometry(m_window->geometry());
+        show();
+    }
+    else
+    {
+        hide();
+    }
+}
+
+void priv::DebugOverlay::rotateStatistics()
+{
+    m_frameAverage = (m_frameCount > 0) ? m_frameSum / 1e6 / m_frameCount : 0.0;
+    m_frameWorst = m_frameMax;
+    m_framesPerSecond = m_frameCount;
+    m_frameSum = 0;
+    m_frameMax = 0;
+    m_frameCount = 0;
+
+    // Only the classes that repaint the most are shown.
+    m_lastCounts.clear();
+    for (auto it = m_paintCounts.cbegin(); it != m_paintCounts.cend(); ++it)
+    {
+        m_lastCounts.append(qMakePair(it.key(), it.value()));
+    }
+
+    std::sort(m_lastCounts.begin(), m_lastCounts.end(),
+        [](const QPair<QString,int>& a, const QPair<QString,int>& b)
+        {
+            return a.second > b.second;
+        });
+
+    if (m_lastCounts.size() > c_maximumClasses)
+    {
+        m_lastCounts.resize(c_maximumClasses);
+    }
+
+    m_paintCounts.clear();
+}
+
+QString priv::DebugOverlay::className(QObject* object)
+{
+    // Most of the private widgets do not have meta-object information of their
+    // own, hence the class name is retrieved through RTTI and cached.
+    const char* mangled = typeid(*object).name();
+    auto it = m_classNames.find(mangled);
+    if (it != m_classNames.end())
+    {
+        return it.value();
+    }
+
+    QString name = QString::fromLatin1(mangled);
+
+#if defined(Q_CC_GNU) || defined(Q_CC_CLANG)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (demangled != nullptr)
+    {
+        name = QString::fromLatin1(demangled);
+        std::free(demangled);
+    }
+#elif defined(Q_CC_MSVC)
+    // MSVC yields names like "class priv::Titlebar".
+    name = name.mid(name.indexOf(' ') + 1);
+#endif
+
+    return m_classNames.insert(mangled, name).value();
+}
@@ -23,87 +23,113 @@
 #include <QOffice/Design/OfficeAccent.hpp>
 #include <QOffice/Design/OfficeImage.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 #include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
 #include <QOffice/Widgets/Dialogs/OfficeWindowTitlebar.hpp>
 
 #include <QPainter>
+#include <QTextBoundaryFinder>
+#include <QTextLayout>
 #include <QtEvents>
+#include <QtMath>
+#include <limits>
 
 OffAnonymous(QOFFICE_CONSTEXPR int c_titlePaddingX = 24)
 OffAnonymous(QOFFICE_CONSTEXPR int c_titlePaddingY = 10)
 OffAnonymous(QOFFICE_CONSTEXPR int c_windowButtonX = 10)
 OffAnonymous(QOFFICE_CONSTEXPR int c_windowButtonY = 8)
+OffAnonymous(QOFFICE_CONSTEXPR int c_glyphSize = 10)
+OffAnonymous(const char* const c_titleEllipsis = "...")
 
 priv::Titlebar::Titlebar(OfficeWindow* window)
     : QWidget(window)
     , m_window(window)
     , m_windowLabelMenu(new OfficeWindowMenu(this, OfficeWindowMenu::LabelMenu))
     , m_windowQuickMenu(new OfficeWindowMenu(this, OfficeWindowMenu::QuickMenu))
-    , m_stateClose(ButtonNone)
-    , m_stateMaximize(ButtonNone)
-    , m_stateMinimize(ButtonNone)
-    , m_imageClose(QPixmap(":/qoffice/images/window/close.png"))
-    , m_imageMaximize(QPixmap(":/qoffice/images/window/max.png"))
-    , m_imageMinimize(QPixmap(":/qoffice/images/window/min.png"))
-    , m_imageRestore(QPixmap(":/qoffice/images/window/restore.png"))
 {
+    m_buttons[CloseButton]    = { QRect(), ButtonNone, OfficeWindow::NoCloseButton };
+    m_buttons[MaximizeButton] = { QRect(), ButtonNone, OfficeWindow::NoMaximizeButton };
+    m_buttons[MinimizeButton] = { QRect(), ButtonNone, OfficeWindow::NoMinimizeButton };
+
+    m_elision.fullWidth = 0.0;
+    m_elision.ellipsisWidth = 0.0;
+    m_elision.isBidi = false;
+    m_elision.validFrom = 0;
+    m_elision.validTo = 0;
+
+    // The titlebar fills its entire area with the accent color.
+    setAttribute(Qt::WA_OpaquePaintEvent);
     setMouseTracking(true);
 }
 
-void priv::Titlebar::paintEvent(QPaintEvent*)
+void priv::Titlebar::paintEvent(QPaintEvent* event)
 {
+    OffProfileScope("priv::Titlebar::paintEvent");
+
     QPainter painter(this);
     Office::Accent accent = m_window->accent();
 
-    // Background
-    painter.fillRect(m_titleRectangle, OfficeAccent::color(accent));
+    // Only the dirty region is filled. Hovering a window button invalidates
+    // the rectangle of that button alone.
+    const QRect dirty = event->rect() & rect();
 
-    // Titlebar text
+    // Background
+    painter.fillRect(dirty, OfficeAccent::color(accent));
+
+    // When the window is not active, the titlebar text and the titlebar
+    // buttons should not be rendered darker but rather blend into the
+    // background. The alpha is baked into the colors for that purpose.
+    QColor foreground = OfficePalette::color(OfficePalette::Background);
+    QColor colorHover = OfficeAccent::lightColor(accent);
+    QColor colorPress = OfficeAccent::darkColor(accent);
     if (!m_window->isActive())
     {
-        // When the window is not active, the titlebar text and the titlebar
-        // buttons should not be rendered darker but rather blend into the
-        // background.
-        painter.setOpacity(0.5);
+        foreground.setAlphaF(0.5);
+        colorHover.setAlphaF(0.5);
+        colorPress.setAlphaF(0.5);
     }
 
-    painter.setFont(font());
-    painter.setPen(OfficePalette::color(OfficePalette::Background));
-    painter.drawText(m_titleRectangle, m_visibleTitle, QTextOption(Qt::AlignCenter));
-
-    // Window button background
-    if (m_stateClose == ButtonHover)
-        painter.fillRect(m_closeRectangle, OfficeAccent::lightColor(accent));
-    else if (m_stateMaximize == ButtonHover)
-        painter.fillRect(m_maximizeRectangle, OfficeAccent::lightColor(accent));
-    else if (m_stateMinimize == ButtonHover)
-        painter.fillRect(m_minimizeRectangle, OfficeAccent::lightColor(accent));
-    else if (m_stateClose == ButtonPress)
-        painter.fillRect(m_closeRectangle, OfficeAccent::darkColor(accent));
-    else if (m_stateMaximize == ButtonPress)
-        painter.fillRect(m_maximizeRectangle, OfficeAccent::darkColor(accent));
-    else if (m_stateMinimize == ButtonPress)
-        painter.fillRect(m_minimizeRectangle, OfficeAccent::darkColor(accent));
-
-    // Window button icons
-    if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoCloseButton))
+    // Titlebar text
+    if (!m_visibleTitle.isEmpty() && dirty.intersects(m_visibleTitleRectangle))
     {
-        painter.drawPixmap(centerRectangle(m_imageClose, m_closeRectangle), m_imageClose);
+        painter.setFont(font());
+        painter.setPen(foreground);
+        painter.drawText(m_titleRectangle, m_visibleTitle, QTextOption(Qt::AlignCenter));
     }
-    if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMinimizeButton))
+
+    // Window buttons
+    const OfficeImage::CaptionGlyph glyphs[ButtonCount] =
     {
-        painter.drawPixmap(centerRectangle(m_imageMinimize, m_minimizeRectangle), m_imageMinimize);
-    }
-    if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMaximizeButton))
+        OfficeImage::CloseGlyph,
+        m_window->isMaximized() ? OfficeImage::RestoreGlyph : OfficeImage::MaximizeGlyph,
+        OfficeImage::MinimizeGlyph
+    };
+
+    const QSize glyphSize(c_glyphSize, c_glyphSize);
+    const qreal ratio = devicePixelRatioF();
+
+    for (int i = 0; i < ButtonCount; ++i)
     {
-        if (m_window->isMaximized())
+        const CaptionButton& button = m_buttons[i];
+        if (OffHasFlag(m_window->m_flagsWindow, button.hideFlag) ||
+            !dirty.intersects(button.rect))
         {
-            painter.drawPixmap(centerRectangle(m_imageRestore, m_maximizeRectangle), m_imageRestore);
+            continue;
         }
-        else
+
+        if (button.state == ButtonHover)
         {
-            painter.drawPixmap(centerRectangle(m_imageMaximize, m_maximizeRectangle), m_imageMaximize);
+            painter.fillRect(button.rect, colorHover);
         }
+        else if (button.state == ButtonPress)
+        {
+            painter.fillRect(button.rect, colorPress);
+        }
+
+        // The glyphs are cached, so this is a hash lookup after the first paint.
+        const QPixmap glyph = OfficeImage::captionGlyph(glyphs[i], glyphSize, ratio, foreground);
+        painter.drawPixmap(OfficeImage::centerRectangle(glyph, button.rect), glyph);
     }
 }
 
@@ -111,14 +137,11 @@ void priv::Titlebar::mouseMoveEvent(QMouseEvent* event)
 {
     const QPoint pos = event->pos();
 
-    // Performs several hit-tests. If one of these functions returns true,
-    // the title bar will be redrawn.
+    // Either drags the window or updates the state of the window buttons,
+    // which repaints only the buttons whose state actually changed.
     if (!mouseMoveDrag(pos))
     {
-        if (mouseMoveSpecial(pos) || mouseMoveHitTest(pos))
-        {
-            update();
-        }
+        mouseMoveHitTest(pos);
     }
 
     QWidget::mouseMoveEvent(event);
@@ -134,10 +157,7 @@ void priv::Titlebar::mousePressEvent(QMouseEvent* event)
             return;
         }
 
-        if (mousePressHitTest(pos))
-        {
-            update();
-        }
+        mousePressHitTest(pos);
     }
 
     QWidget::mousePressEvent(event);
@@ -153,10 +173,7 @@ void priv::Titlebar::mouseReleaseEvent(QMouseEvent* event)
             return;
         }
 
-        if (mouseReleaseAction(pos))
-        {
-            update();
-        }
+        mouseReleaseAction(pos);
     }
 
     QWidget::mouseReleaseEvent(event);
@@ -185,9 +202,8 @@ void priv::Titlebar::mouseDoubleClickEvent(QMouseEvent* event)
             m_window->showMaximized();
         }
 
-        m_stateMaximize = ButtonNone;
+        resetButtons();
         m_window->update();
-        update();
     }
 
     m_window->updateLayoutPadding();
@@ -203,11 +219,7 @@ void priv::Titlebar::leaveEvent(QEvent* event)
     }
     else
     {
-        m_stateClose    = ButtonNone;
-        m_stateMaximize = ButtonNone;
-        m_stateMinimize = ButtonNone;
-
-        update();
+        resetButtons();
     }
 
     QWidget::leaveEvent(event);
@@ -215,18 +227,41 @@ void priv::Titlebar::leaveEvent(QEvent* event)
 
 void priv::Titlebar::updateRectangles()
 {
-    const QSize& sizeClose = m_imageClose.size();
-    const QSize& sizeMaxim = m_imageMaximize.size();
-    const QSize& sizeMinim = m_imageMinimize.size();
+    OffProfileScope("priv::Titlebar::updateRectangles");
+
+    const QSize sizeClose(c_glyphSize, c_glyphSize);
+    const QSize sizeMaxim(c_glyphSize, c_glyphSize);
+    const QSize sizeMinim(c_glyphSize, c_glyphSize);
 
     // Initial button position.
     int initialX = width() - sizeClose.width() - c_windowButtonX;
     int initialY = c_windowButtonY;
 
-    int totalWidth =
-        m_closeRectangle.width()    +
-        m_maximizeRectangle.width() +
-        m_minimizeRectangle.width();
+    // The buttons are laid out from right to left. Hidden buttons get an
+    // empty rectangle, so hit-tests and repaints can skip them for free.
+    const QSize sizes[ButtonCount] = { sizeClose, sizeMaxim, sizeMinim };
+    const QSize advances[ButtonCount] = { sizeMaxim, sizeMinim, QSize() };
+
+    int totalWidth = 0;
+    for (int i = 0; i < ButtonCount; ++i)
+    {
+        CaptionButton& button = m_buttons[i];
+        if (OffHasFlag(m_window->m_flagsWindow, button.hideFlag))
+        {
+            button.rect = QRect();
+            continue;
+        }
+
+        button.rect.setRect(
+            initialX - 10,
+            initialY - 8,
+            sizes[i].width()  + 20,
+            sizes[i].height() + 16
+            );
+
+        totalWidth += button.rect.width();
+        initialX -= advances[i].width() + 20;
+    }
 
     int dragWidth =
         width()     -
@@ -234,76 +269,155 @@ void priv::Titlebar::updateRectangles()
         m_windowLabelMenu->width() -
         m_windowQuickMenu->width();
 
-    // Close button rectangle
-    if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoCloseButton))
+    // Misc rectangles
+    m_dragRectangle.setRect(m_windowQuickMenu->width(), 0, dragWidth, height());
+    m_titleRectangle.setRect(0, 0, width(), height());
+    m_windowLabelMenu->move(m_dragRectangle.x() + m_dragRectangle.width(), 0);
+    m_windowQuickMenu->move(0, 0);
+}
+
+void priv::Titlebar::updateVisibleTitle()
+{
+    OffProfileScope("priv::Titlebar::updateVisibleTitle");
+
+    const QString& title = m_window->windowTitle();
+    if (title != m_elision.title || font() != m_elision.font)
     {
-        m_closeRectangle.setRect(
-            initialX - 10,
-            initialY - 8,
-            sizeClose.width()  + 20,
-            sizeClose.height() + 16
-            );
+        shapeTitle(title);
+    }
+
+    // The title is centered within the whole titlebar, but may not leave the
+    // drag rectangle, otherwise it would overlap the menus or window buttons.
+    const int center = m_titleRectangle.center().x();
+    const int left   = m_dragRectangle.left()  + c_titlePaddingX;
+    const int right  = m_dragRectangle.right() - c_titlePaddingX;
+    const int available = qMax(0, qMin(center - left, right - center) * 2);
 
-        initialX -= sizeMaxim.width() + 20;
+    // The elided title stays the same for a whole range of widths. Resizing
+    // the window within that range does not require any work.
+    if (available < m_elision.validFrom || available >= m_elision.validTo)
+    {
+        elideTitle(available);
     }
 
-    // Maximize button rectangle
-    if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMaximizeButton))
+    m_visibleTitleRectangle = QFontMetrics(font()).boundingRect(
+        m_titleRectangle,
+        Qt::AlignCenter,
+        m_visibleTitle
+        );
+}
+
+void priv::Titlebar::shapeTitle(const QString& title)
+{
+    m_elision.title = title;
+    m_elision.font = font();
+    m_elision.boundaries.clear();
+    m_elision.advances.clear();
+    m_elision.ellipsisWidth = QFontMetricsF(font()).width(c_titleEllipsis);
+    m_elision.isBidi = false;
+    m_elision.validFrom = 0;
+    m_elision.validTo = 0;
+
+    // Logical prefixes only map to visual prefixes in left-to-right text. Any
+    // right-to-left character makes the elision fall back to Qt's bidi-aware
+    // implementation.
+    for (uint ucs4 : title.toUcs4())
     {
-        m_maximizeRectangle.setRect(
-            initialX - 10,
-            initialY - 8,
-            sizeMaxim.width()  + 20,
-            sizeMaxim.height() + 16
-            );
+        const QChar::Direction direction = QChar::direction(ucs4);
+        if (direction == QChar::DirR   ||
+            direction == QChar::DirAL  ||
+            direction == QChar::DirRLE ||
+            direction == QChar::DirRLO ||
+            direction == QChar::DirRLI)
+        {
+            m_elision.isBidi = true;
+            m_elision.fullWidth = QFontMetricsF(font()).width(title);
+            return;
+        }
+    }
 
-        initialX -= sizeMinim.width() + 20;
+    // Shapes the title exactly once. The advance of every prefix that ends on
+    // a grapheme boundary is recorded, so a later elision only has to do a
+    // binary search and never cuts a grapheme cluster in half.
+    QTextOption option;
+    option.setWrapMode(QTextOption::NoWrap);
+
+    QTextLayout layout(title, font());
+    layout.setTextOption(option);
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    if (line.isValid())
+    {
+        line.setNumColumns(title.length());
     }
+    layout.endLayout();
 
-    // Minimize button rectangle
-    if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMinimizeButton))
+    QTextBoundaryFinder finder(QTextBoundaryFinder::Grapheme, title);
+    for (int pos = 0; pos != -1; pos = finder.toNextBoundary())
     {
-        m_minimizeRectangle.setRect(
-            initialX - 10,
-            initialY - 8,
-            sizeMinim.width()  + 20,
-            sizeMinim.height() + 16
-            );
+        m_elision.boundaries.append(pos);
+        m_elision.advances.append(line.isValid() ? line.cursorToX(pos) : 0.0);
     }
 
-    // Misc rectangles
-    m_dragRectangle.setRect(m_windowQuickMenu->width(), 0, dragWidth, height());
-    m_titleRectangle.setRect(0, 0, width(), height());
-    m_windowLabelMenu->move(m_dragRectangle.x() + m_dragRectangle.width(), 0);
-    m_windowQuickMenu->move(0, 0);
+    m_elision.fullWidth = line.isValid() ? line.naturalTextWidth() : 0.0;
 }
 
-void priv::Titlebar::updateVisibleTitle()
+void priv::Titlebar::elideTitle(int available)
 {
-    QString title = m_window->windowTitle();
-    QFontMetrics metrics(font());
-
-    int currentWidth = metrics.width(title);
-    int estimatedWidth = m_dragRectangle.width() - c_titlePaddingX * 2 - currentWidth;
+    const QString& title = m_elision.title;
+    const int fullWidth = qCeil(m_elision.fullWidth);
 
-    // Removes characters as long as it does not overlap the window buttons.
-    while (currentWidth > estimatedWidth && estimatedWidth > 0)
+    if (fullWidth <= available)
     {
-        title.remove(title.length() - 1, 1);
-        currentWidth = metrics.width(title);
+        m_visibleTitle = title;
+        m_elision.validFrom = fullWidth;
+        m_elision.validTo = std::numeric_limits<int>::max();
+        return;
     }
 
-    // Displays dots behind the modified title.
-    if (title.length() < 3 || estimatedWidth < currentWidth)
+    if (m_elision.isBidi)
     {
-        title = "";
+        m_visibleTitle = QFontMetrics(font()).elidedText(title, Qt::ElideRight, available);
+        m_elision.validFrom = available;
+        m_elision.validTo = available + 1;
+        return;
     }
-    else if (m_window->windowTitle().length() != title.length())
+
+    // Finds the longest prefix that still fits along with the ellipsis. The
+    // first boundary is always zero, the last one is the title's length.
+    const QVector<qreal>& advances = m_elision.advances;
+    const qreal budget = available - m_elision.ellipsisWidth;
+
+    int low = 0;
+    int high = advances.size() - 1;
+    while (low < high)
     {
-        title.remove(title.length() - 2, 2).append("...");
+        const int middle = (low + high + 1) / 2;
+        if (advances[middle] <= budget)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
     }
 
-    m_visibleTitle = title;
+    // The elided title is valid for every width until the next grapheme fits.
+    const int next = qMin(low + 1, advances.size() - 1);
+    m_elision.validTo = qMin(fullWidth, qCeil(advances[next] + m_elision.ellipsisWidth));
+
+    if (low == 0)
+    {
+        // Not even a single grapheme fits, so no title is shown at all.
+        m_visibleTitle.clear();
+        m_elision.validFrom = std::numeric_limits<int>::min();
+    }
+    else
+    {
+        m_visibleTitle = title.left(m_elision.boundaries[low]) + c_titleEllipsis;
+        m_elision.validFrom = qCeil(advances[low] + m_elision.ellipsisWidth);
+    }
 }
 
 bool priv::Titlebar::mouseMoveDrag(const QPoint& pos)
@@ -313,7 +427,7 @@ bool priv::Titlebar::mouseMoveDrag(const QPoint& pos)
         auto globalPos = m_window->mapToGlobal(pos);
         if (m_window->isMaximized())
         {
-            m_stateMaximize = ButtonNone;
+            m_buttons[MaximizeButton].state = ButtonNone;
             m_window->m_stateWindow = OfficeWindow::StateNone;
 
             // The window is about to be restored. In order to avoid that all
@@ -324,6 +438,12 @@ bool priv::Titlebar::mouseMoveDrag(const QPoint& pos)
 
             m_window->showNormal();
         }
+        else if (m_window->startSystemMove())
+        {
+            // The window system moves the window from now on. It does not
+            // necessarily deliver the mouse release event to us afterwards.
+            m_window->m_stateWindow = OfficeWindow::StateNone;
+        }
         else
         {
             m_window->move(globalPos - m_dragPosition);
@@ -336,89 +456,25 @@ bool priv::Titlebar::mouseMoveDrag(const QPoint& pos)
     return false;
 }
 
-bool priv::Titlebar::mouseMoveSpecial(const QPoint& pos)
+void priv::Titlebar::mouseMoveHitTest(const QPoint& pos)
 {
-    // Special <> press
-    if (m_stateClose == ButtonSpecial && m_closeRectangle.contains(pos))
-    {
-        m_stateClose = ButtonPress;
-        return true;
-    }
-    else if (m_stateMaximize == ButtonSpecial && m_maximizeRectangle.contains(pos))
-    {
-        m_stateMaximize = ButtonPress;
-        return true;
-    }
-    else if (m_stateMinimize == ButtonSpecial && m_minimizeRectangle.contains(pos))
-    {
-        m_stateMinimize = ButtonPress;
-        return true;
-    }
+    const int hit = buttonAt(pos);
+    const int active = activeButton();
 
-    // Press <> special
-    if (m_stateClose == ButtonPress && !m_closeRectangle.contains(pos))
-    {
-        m_stateClose = ButtonSpecial;
-        return true;
-    }
-    else if (m_stateMaximize == ButtonPress && !m_maximizeRectangle.contains(pos))
-    {
-        m_stateMaximize = ButtonSpecial;
-        return true;
-    }
-    else if (m_stateMinimize == ButtonPress && !m_minimizeRectangle.contains(pos))
+    if (active != -1)
     {
-        m_stateMinimize = ButtonSpecial;
-        return true;
+        // While a button is being pressed, it toggles between the pressed and
+        // the special state as the mouse pointer enters and leaves it.
+        setButtonState(active, (hit == active) ? ButtonPress : ButtonSpecial);
+        return;
     }
 
-    return false;
-}
-
-bool priv::Titlebar::mouseMoveHitTest(const QPoint& pos)
-{
     // Changes the button into hovered state if the mouse pointer happens to
-    // hover it.
-    if (m_stateClose    != ButtonPress   &&
-        m_stateClose    != ButtonSpecial &&
-        m_stateMaximize != ButtonPress   &&
-        m_stateMaximize != ButtonSpecial &&
-        m_stateMinimize != ButtonPress   &&
-        m_stateMinimize != ButtonSpecial)
-    {
-        // Determines whether one button has been hovered before. If yes, do not
-        // perform a repaint of the title bar.
-        bool state = m_stateClose    != ButtonHover &&
-                     m_stateMaximize != ButtonHover &&
-                     m_stateMinimize != ButtonHover;
-
-        m_stateClose    = ButtonNone;
-        m_stateMaximize = ButtonNone;
-        m_stateMinimize = ButtonNone;
-
-        if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoCloseButton) &&
-            m_closeRectangle.contains(pos))
-        {
-            m_stateClose = ButtonHover;
-            return true;
-        }
-        else if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMaximizeButton) &&
-            m_maximizeRectangle.contains(pos))
-        {
-            m_stateMaximize = ButtonHover;
-            return true;
-        }
-        else if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMinimizeButton) &&
-            m_minimizeRectangle.contains(pos))
-        {
-            m_stateMinimize = ButtonHover;
-            return true;
-        }
-
-        return state;
+    // hover it. All other buttons lose their hover state.
+    for (int i = 0; i < ButtonCount; ++i)
+    {
+        setButtonState(i, (i == hit) ? ButtonHover : ButtonNone);
     }
-
-    return false;
 }
 
 bool priv::Titlebar::mousePressDrag(const QPoint& pos)
@@ -436,36 +492,13 @@ bool priv::Titlebar::mousePressDrag(const QPoint& pos)
     return false;
 }
 
-bool priv::Titlebar::mousePressHitTest(const QPoint& pos)
+void priv::Titlebar::mousePressHitTest(const QPoint& pos)
 {
-    bool state = m_stateClose    != ButtonPress &&
-                 m_stateMaximize != ButtonPress &&
-                 m_stateMinimize != ButtonPress;
-
-    m_stateClose    = ButtonNone;
-    m_stateMaximize = ButtonNone;
-    m_stateMinimize = ButtonNone;
-
-    if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoCloseButton) &&
-        m_closeRectangle.contains(pos))
-    {
-        m_stateClose = ButtonPress;
-        return true;
-    }
-    else if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMaximizeButton) &&
-        m_maximizeRectangle.contains(pos))
-    {
-        m_stateMaximize = ButtonPress;
-        return true;
-    }
-    else if (OffHasNotFlag(m_window->m_flagsWindow, OfficeWindow::NoMinimizeButton) &&
-        m_minimizeRectangle.contains(pos))
+    const int hit = buttonAt(pos);
+    for (int i = 0; i < ButtonCount; ++i)
     {
-        m_stateMinimize = ButtonPress;
-        return true;
+        setButtonState(i, (i == hit) ? ButtonPress : ButtonNone);
     }
-
-    return state;
 }
 
 bool priv::Titlebar::mouseReleaseDrag(const QPoint&)
@@ -480,59 +513,112 @@ bool priv::Titlebar::mouseReleaseDrag(const QPoint&)
     return false;
 }
 
-bool priv::Titlebar::mouseReleaseAction(const QPoint& pos)
+void priv::Titlebar::mouseReleaseAction(const QPoint& pos)
+{
+    const int active = activeButton();
+    if (active == -1)
+    {
+        return;
+    }
+
+    const bool triggered = m_buttons[active].state == ButtonPress &&
+                           m_buttons[active].rect.contains(pos);
+
+    // The states are reset before triggering, since the action might as well
+    // destroy the window.
+    for (int i = 0; i < ButtonCount; ++i)
+    {
+        setButtonState(i, (i == buttonAt(pos)) ? ButtonHover : ButtonNone);
+    }
+
+    if (triggered)
+    {
+        triggerButton(active);
+    }
+}
+
+void priv::Titlebar::triggerButton(int button)
 {
-    if (m_stateClose    == ButtonPress   ||
-        m_stateClose    == ButtonSpecial ||
-        m_stateMaximize == ButtonPress   ||
-        m_stateMaximize == ButtonSpecial ||
-        m_stateMinimize == ButtonPress   ||
-        m_stateMinimize == ButtonSpecial)
-    {
-        if (m_stateClose == ButtonPress && m_closeRectangle.contains(pos))
+    switch (button)
+    {
+    case CloseButton:
+        m_window->close();
+        break;
+
+    case MaximizeButton:
+        // The window is about to be maximized or restored. In order to avoid
+        // that all the titlebar's contents are invisible for a split second,
+        // we recalculate all the necessary things beforehand.
+        updateRectangles();
+        updateVisibleTitle();
+        m_window->updateResizeRectangles();
+
+        if (m_window->isMaximized())
         {
-            m_window->close();
+            m_window->showNormal();
         }
-        else if (m_stateMaximize == ButtonPress && m_maximizeRectangle.contains(pos))
+        else
         {
-            // The window is about to be maximized or restored. In order to
-            // avoid that all the titlebar's contents are invisible for a split
-            // second, we recalculate all the necessary things beforehand.
-            updateRectangles();
-            updateVisibleTitle();
-            m_window->updateResizeRectangles();
+            m_window->showMaximized();
+        }
 
-            if (m_window->isMaximized())
-            {
-                m_window->showNormal();
-            }
-            else
-            {
-                m_window->showMaximized();
-            }
+        m_window->updateLayoutPadding();
+        break;
 
-            m_window->updateLayoutPadding();
-        }
-        else if (m_stateMinimize == ButtonPress && m_minimizeRectangle.contains(pos))
+    case MinimizeButton:
+        m_window->updateLayoutPadding();
+        m_window->showMinimized();
+        break;
+    }
+}
+
+int priv::Titlebar::buttonAt(const QPoint& pos) const
+{
+    for (int i = 0; i < ButtonCount; ++i)
+    {
+        if (m_buttons[i].rect.contains(pos))
         {
-            m_window->updateLayoutPadding();
-            m_window->showMinimized();
+            return i;
         }
+    }
 
-        m_stateClose    = ButtonNone;
-        m_stateMaximize = ButtonNone;
-        m_stateMinimize = ButtonNone;
+    return -1;
+}
 
-        return true;
+int priv::Titlebar::activeButton() const
+{
+    for (int i = 0; i < ButtonCount; ++i)
+    {
+        if (m_buttons[i].state == ButtonPress ||
+            m_buttons[i].state == ButtonSpecial)
+        {
+            return i;
+        }
     }
 
-    return false;
+    return -1;
 }
 
-QRect priv::Titlebar::centerRectangle(const QPixmap& pm, const QRect& rc)
+void priv::Titlebar::setButtonState(int button, ButtonState state)
 {
-    int dx = (rc.width()  - pm.width())  / 2;
-    int dy = (rc.height() - pm.height()) / 2;
+    // Flat hover states keep the buttons from repainting on every pass.
+    if (state == ButtonHover && !OfficePerformance::isHoverEnabled())
+    {
+        state = ButtonNone;
+    }
 
-    return QRect(rc.x() + dx, rc.y() + dy, pm.width(), pm.height());
+    CaptionButton& target = m_buttons[button];
+    if (target.state != state)
+    {
+        target.state = state;
+        update(target.rect);
+    }
+}
+
+void priv::Titlebar::resetButtons()
+{
+    for (int i = 0; i < ButtonCount; ++i)
+    {
+        setButtonState(i, ButtonNone);
+    }
 }
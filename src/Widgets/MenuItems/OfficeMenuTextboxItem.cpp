@@ -22,6 +22,8 @@
 
 #include <QOffice/Widgets/MenuItems/OfficeMenuTextboxItem.hpp>
 
+#include <QDataStream>
+
 OfficeMenuTextboxItem::OfficeMenuTextboxItem(const QString& initialText)
     : OfficeLineEdit()
 {
@@ -42,6 +44,38 @@ QWidget* OfficeMenuTextboxItem::widget()
     return this;
 }
 
+QByteArray OfficeMenuTextboxItem::saveState() const
+{
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << text();
+
+    return state;
+}
+
+bool OfficeMenuTextboxItem::restoreState(const QByteArray& state)
+{
+    QDataStream stream(state);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    QString restored;
+    stream >> restored;
+    if (stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    restoreText(restored);
+    return true;
+}
+
+QString OfficeMenuTextboxItem::searchText()
+{
+    // The text itself is user content, the placeholder describes the command.
+    return placeholderText().isEmpty() ? accessibleName() : placeholderText();
+}
+
 void OfficeMenuTextboxItem::onTextChanged(QString previous, QString current)
 {
     OfficeMenuTextChangedEvent event(id(), previous, current);
@@ -119,6 +119,15 @@ void OfficeLineEdit::keyPressEvent(QKeyEvent* event)
     QLineEdit::keyPressEvent(event);
 }
 
+void OfficeLineEdit::restoreText(const QString& text)
+{
+    const QSignalBlocker blocker(this);
+    setText(text);
+
+    // The restored text is the base for the next OfficeMenuTextChangedEvent.
+    m_previous = text;
+}
+
 void OfficeLineEdit::generateEvent()
 {
     if (!m_hasTyped)
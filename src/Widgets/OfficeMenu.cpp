@@ -22,27 +22,47 @@
 
 #include <QOffice/Design/OfficeAccent.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/OfficeLineEdit.hpp>
 #include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuCommandIndex.hpp>
 #include <QOffice/Widgets/OfficeMenuHeader.hpp>
 #include <QOffice/Widgets/OfficeMenuItem.hpp>
+#include <QOffice/Widgets/OfficeMenuKeyTips.hpp>
 #include <QOffice/Widgets/OfficeMenuPanel.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelButton.hpp>
 
+#include <QAbstractButton>
 #include <QApplication>
 #include <QBoxLayout>
+#include <QCompleter>
+#include <QDataStream>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QStringListModel>
 
 OffAnonymous(QOFFICE_CONSTEXPR int c_collapsedHeight = 30)
 OffAnonymous(QOFFICE_CONSTEXPR int c_expandedHeight = 120)
+OffAnonymous(QOFFICE_CONSTEXPR quint32 c_stateMagic = 0x514F4D53) // "QOMS"
+OffAnonymous(QOFFICE_CONSTEXPR quint16 c_stateVersion = 1)
+OffAnonymous(QOFFICE_CONSTEXPR int c_searchWidth = 180)
+OffAnonymous(QOFFICE_CONSTEXPR int c_searchResults = 12)
 OffAnonymous(QOFFICE_CONSTEXPR Qt::Alignment c_flags = Qt::AlignLeft | Qt::AlignTop | Qt::AlignHCenter)
 
 OfficeMenu::OfficeMenu(QWidget* parent)
     : QWidget(parent)
     , m_headerLayout(new QHBoxLayout)
     , m_panelLayout(new QHBoxLayout)
+    , m_keyTips(nullptr)
+    , m_commandIndex(new priv::CommandIndex(this))
+    , m_searchBox(nullptr)
+    , m_searchCompleter(nullptr)
+    , m_searchModel(nullptr)
     , m_isExpanded(false)
     , m_isPinned(false)
     , m_isTooltipShown(false)
+    , m_isOverlay(false)
+    , m_isFloating(false)
 {
     QVBoxLayout* container = new QVBoxLayout(this);
     container->setContentsMargins(0,0,0,0);
@@ -63,8 +83,13 @@ OfficeMenu::OfficeMenu(QWidget* parent)
     setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed);
     setLayout(container);
 
+    // The menu paints every pixel itself, see OfficeMenu::paintEvent.
+    setAttribute(Qt::WA_OpaquePaintEvent);
     setFocusPolicy(Qt::ClickFocus);
     setProperty("qoffice_menu", true);
+
+    // Created last, so that the key tips are painted above the panel bars.
+    m_keyTips = new priv::KeyTips(this);
 }
 
 OfficeMenuHeader* OfficeMenu::headerById(int id) const
@@ -122,6 +147,15 @@ void OfficeMenu::setPinned(bool pinned, bool c)
     m_isPinned = pinned;
     setFocus();
 
+    // The pin button of the expanded header reflects the pinned state.
+    update();
+
+    // A floating menu starts taking layout space once pinned, and vice versa.
+    if (m_isOverlay && m_isExpanded)
+    {
+        updateHeight();
+    }
+
     if (!pinned && c)
     {
         collapse();
@@ -155,6 +189,7 @@ OfficeMenuHeader* OfficeMenu::insertHeader(int pos, int id, const QString& text)
 
     m_headers.insert(pos, header);
     m_headerLayout->insertWidget(pos, header, 0, c_flags);
+    invalidateKeyTips();
 
     return header;
 }
@@ -166,6 +201,7 @@ bool OfficeMenu::removeHeader(int id)
     {
         m_headers.removeOne(header);
         m_headerLayout->removeWidget(header);
+        invalidateKeyTips();
 
         delete header;
     }
@@ -177,6 +213,8 @@ void OfficeMenu::expand(OfficeMenuHeader* toExpand)
 {
     if (toExpand != nullptr)
     {
+        const bool wasExpanded = m_isExpanded;
+
         // Collapses any other open headers.
         for (auto* header : m_headers)
         {
@@ -188,29 +226,297 @@ void OfficeMenu::expand(OfficeMenuHeader* toExpand)
         // located outside the parent's bounds, are invisible. In this case, the
         // panel bar at the bottom of the headers would not be visible. In order
         // for it to be visible, we need to resize the topmost parent.
-        resize(width(), c_expandedHeight);
-        setFixedHeight(c_expandedHeight);
+        m_isExpanded = true;
+        updateHeight();
         setFocus();
 
-        toExpand->expand(m_panelLayout, m_isExpanded);
-
-        m_isExpanded = true;
+        toExpand->expand(m_panelLayout, wasExpanded);
+        invalidateKeyTips();
     }
 }
 
 void OfficeMenu::collapse()
 {
+    // The state is reset first, since headers that collapse without an
+    // animation call OfficeMenu::collapseFinished right away.
+    const bool wasExpanded = m_isExpanded;
+    m_isExpanded = false;
+
     // Collapses all headers.
     for (auto* header : m_headers)
     {
-        header->collapse(m_panelLayout, m_isExpanded);
+        header->collapse(m_panelLayout, wasExpanded);
     }
 
-    m_isExpanded = false;
+    invalidateKeyTips();
+}
+
+QByteArray OfficeMenu::saveState() const
+{
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    qint32 expandedId = -1;
+    for (auto* header : m_headers)
+    {
+        if (header->isSelected())
+        {
+            expandedId = header->id();
+        }
+    }
+
+    stream << c_stateMagic << c_stateVersion << expandedId << m_isPinned;
+
+    // Only items that actually have a state are written, each of them as an
+    // opaque blob, so that an item never reads past the state of its own.
+    QList<QByteArray> items;
+    for (auto* header : m_headers)
+    for (auto* panel : header->m_panels)
+    {
+        QList<QPair<int,QByteArray>> states;
+        for (auto* item : panel->m_items)
+        {
+            states.append(qMakePair(item->id(), item->saveState()));
+        }
+
+        // The state of a light item is whether it is toggled.
+        for (const auto& slot : panel->m_lightItems)
+        {
+            if (slot.item.isToggable())
+            {
+                QByteArray lightState;
+                QDataStream lightStream(&lightState, QIODevice::WriteOnly);
+                lightStream.setVersion(QDataStream::Qt_5_0);
+                lightStream << slot.item.isToggled();
+
+                states.append(qMakePair(slot.id, lightState));
+            }
+        }
+
+        for (const auto& state : states)
+        {
+            if (!state.second.isNull())
+            {
+                QByteArray record;
+                QDataStream recordStream(&record, QIODevice::WriteOnly);
+                recordStream.setVersion(QDataStream::Qt_5_0);
+                recordStream
+                    << qint32(header->id())
+                    << qint32(panel->id())
+                    << qint32(state.first)
+                    << state.second;
+
+                items.append(record);
+            }
+        }
+    }
+
+    stream << items;
+
+    return state;
+}
+
+bool OfficeMenu::restoreState(const QByteArray& state)
+{
+    QDataStream stream(state);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    qint32 expandedId = -1;
+    bool pinned = false;
+    QList<QByteArray> items;
+
+    stream >> magic >> version;
+    if (magic != c_stateMagic || version != c_stateVersion)
+    {
+        return false;
+    }
+
+    // The snapshot is read entirely before anything is applied, so a broken
+    // one does not leave the menu in a half-restored state.
+    stream >> expandedId >> pinned >> items;
+    if (stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    m_isPinned = pinned;
+
+    // Collapses and expands the headers directly, without animations and
+    // without emitting OfficeMenuHeader::headerExpanded and headerCollapsed.
+    for (auto* header : m_headers)
+    {
+        const QSignalBlocker blocker(header);
+        header->collapse(m_panelLayout, false);
+    }
+
+    OfficeMenuHeader* expanded = headerById(expandedId);
+
+    m_isExpanded = (expanded != nullptr);
+    updateHeight();
+
+    if (expanded != nullptr)
+    {
+        const QSignalBlocker blocker(expanded);
+        expanded->expand(m_panelLayout, true);
+    }
+
+    invalidateKeyTips();
+
+    for (const QByteArray& record : items)
+    {
+        QDataStream recordStream(record);
+        recordStream.setVersion(QDataStream::Qt_5_0);
+
+        qint32 headerId = -1;
+        qint32 panelId = -1;
+        qint32 itemId = -1;
+        QByteArray itemState;
+
+        recordStream >> headerId >> panelId >> itemId >> itemState;
+        if (recordStream.status() != QDataStream::Ok)
+        {
+            continue;
+        }
+
+        OfficeMenuHeader* header = headerById(headerId);
+        OfficeMenuPanel* panel = (header != nullptr) ? header->panelById(panelId) : nullptr;
+        if (panel == nullptr)
+        {
+            continue;
+        }
+
+        if (OfficeMenuItem* item = panel->itemById(itemId))
+        {
+            item->restoreState(itemState);
+        }
+        else if (const OfficeMenuLightItem* light = panel->lightItemById(itemId))
+        {
+            QDataStream lightStream(itemState);
+            lightStream.setVersion(QDataStream::Qt_5_0);
+
+            bool toggled = false;
+            lightStream >> toggled;
+
+            if (lightStream.status() == QDataStream::Ok && light->isToggable())
+            {
+                OfficeMenuLightItem restored = *light;
+                restored.setToggled(toggled);
+                panel->setLightItem(itemId, restored);
+            }
+        }
+    }
+
+    update();
+
+    return true;
+}
+
+bool OfficeMenu::isSearchVisible() const
+{
+    return m_searchBox != nullptr && !m_searchBox->isHidden();
+}
+
+void OfficeMenu::setSearchVisible(bool visible)
+{
+    if (m_searchBox == nullptr)
+    {
+        if (!visible)
+        {
+            return;
+        }
+
+        // The search field is created on demand, since most of the menus
+        // will never show it.
+        m_searchBox = new OfficeLineEdit(this);
+        m_searchBox->setPlaceholderText(tr("Tell me what you want to do"));
+        m_searchBox->setFixedWidth(c_searchWidth);
+        m_searchBox->setProperty("qoffice_menu_item", true);
+        m_searchBox->installEventFilter(this);
+
+        // The index already filters the commands, the completer only shows the
+        // results and must not filter them once again.
+        m_searchModel = new QStringListModel(this);
+        m_searchCompleter = new QCompleter(m_searchModel, this);
+        m_searchCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+        m_searchCompleter->setMaxVisibleItems(c_searchResults);
+        m_searchBox->setCompleter(m_searchCompleter);
+
+        m_headerLayout->addWidget(m_searchBox, 0, Qt::AlignVCenter);
+
+        QObject::connect(
+            m_searchBox,
+            &OfficeLineEdit::textEdited,
+            this,
+            &OfficeMenu::searchTextChanged
+            );
+
+        QObject::connect(
+            m_searchCompleter,
+            static_cast<void (QCompleter::*)(const QModelIndex&)>(&QCompleter::activated),
+            this,
+            &OfficeMenu::searchResultActivated
+            );
+    }
+
+    m_searchBox->setVisible(visible);
+}
+
+QList<OfficeMenuItem*> OfficeMenu::findCommands(const QString& query, int maximum) const
+{
+    QList<OfficeMenuItem*> items;
+    for (const auto& command : m_commandIndex->find(query, -1))
+    {
+        if (maximum >= 0 && items.size() >= maximum)
+        {
+            break;
+        }
+
+        OfficeMenuItem* item = command.first->itemById(command.second);
+        if (item != nullptr)
+        {
+            items.append(item);
+        }
+    }
+
+    return items;
+}
+
+bool OfficeMenu::isOverlayExpansion() const
+{
+    return m_isOverlay;
+}
+
+void OfficeMenu::setOverlayExpansion(bool overlay)
+{
+    if (m_isOverlay == overlay)
+    {
+        return;
+    }
+
+    m_isOverlay = overlay;
+
+    if (overlay)
+    {
+        // The height is controlled by OfficeMenu::sizeHint from now on, which
+        // differs from the actual height while floating.
+        setMinimumHeight(c_collapsedHeight);
+        setMaximumHeight(c_expandedHeight);
+    }
+
+    updateHeight();
 }
 
 QSize OfficeMenu::sizeHint() const
 {
+    // A floating menu only occupies the space of its headers in the layout.
+    if (m_isFloating)
+    {
+        return QSize(parentWidget()->width(), c_collapsedHeight);
+    }
+
     return QSize(parentWidget()->width(), height());
 }
 
@@ -221,10 +527,39 @@ void OfficeMenu::accentUpdateEvent()
 
 void OfficeMenu::paintEvent(QPaintEvent*)
 {
+    OffProfileScope("OfficeMenu::paintEvent");
+
     QPainter painter(this);
     QRect background(0, 0, width(), c_collapsedHeight);
+    QRect remainder(0, c_collapsedHeight, width(), height() - c_collapsedHeight);
 
     painter.fillRect(background, OfficeAccent::color(accent()));
+
+    // The area below the headers is covered by the panel bar most of the time,
+    // but not while it is being animated.
+    if (!remainder.isEmpty())
+    {
+        painter.fillRect(remainder, OfficePalette::color(OfficePalette::Background));
+    }
+}
+
+void OfficeMenu::resizeEvent(QResizeEvent* event)
+{
+    // The parent layout only reserves the collapsed height for a floating menu
+    // and applies it whenever it relayouts, e.g. when the window is resized.
+    if (m_isFloating && height() != c_expandedHeight)
+    {
+        resize(width(), c_expandedHeight);
+    }
+
+    // Chooses the panel tiers that fit the new width. This only sums up the
+    // widths memoised by the panels, so it keeps up with window resizing.
+    for (auto* header : m_headers)
+    {
+        header->updateTiers(width());
+    }
+
+    QWidget::resizeEvent(event);
 }
 
 void OfficeMenu::focusOutEvent(QFocusEvent* event)
@@ -272,3 +607,181 @@ void OfficeMenu::collapseOnFocusLost()
         collapse();
     }
 }
+
+void OfficeMenu::searchTextChanged(const QString& text)
+{
+    OffProfileScope("OfficeMenu::searchTextChanged");
+
+    m_searchResults = m_commandIndex->find(text, c_searchResults);
+
+    QStringList results;
+    for (const auto& command : m_searchResults)
+    {
+        OfficeMenuPanel* panel = command.first;
+        QString title;
+
+        if (OfficeMenuItem* item = panel->itemById(command.second))
+        {
+            title = item->searchText();
+            if (title.isEmpty())
+            {
+                title = item->widget()->toolTip();
+            }
+        }
+        else if (const OfficeMenuLightItem* light = panel->lightItemById(command.second))
+        {
+            title = light->text();
+            if (title.isEmpty())
+            {
+                title = light->toolTip();
+            }
+        }
+
+        if (title.isEmpty())
+        {
+            title = QStringLiteral("#%1").arg(command.second);
+        }
+
+        // The panel tells apart commands with the same text, e.g. "Insert".
+        title.remove(QLatin1Char('&'));
+        results.append(QStringLiteral("%1 (%2)").arg(title, panel->text()));
+    }
+
+    m_searchModel->setStringList(results);
+
+    if (!results.isEmpty())
+    {
+        m_searchCompleter->complete();
+    }
+}
+
+void OfficeMenu::searchResultActivated(const QModelIndex& index)
+{
+    if (index.row() < 0 || index.row() >= m_searchResults.size())
+    {
+        return;
+    }
+
+    const auto command = m_searchResults.at(index.row());
+    OfficeMenuItem* item = command.first->itemById(command.second);
+
+    // The completer inserts the chosen text after this slot returns, which is
+    // not a valid query. The field is therefore cleared once it did so.
+    QMetaObject::invokeMethod(m_searchBox, "clear", Qt::QueuedConnection);
+    m_searchResults.clear();
+
+    if (item != nullptr)
+    {
+        activateItem(item);
+
+        emit commandActivated(item);
+    }
+    else
+    {
+        // Light items report their click through buttonClickedEvent.
+        activateLightItem(command.first, command.second);
+    }
+}
+
+void OfficeMenu::updateHeight()
+{
+    const int height = m_isExpanded ? c_expandedHeight : c_collapsedHeight;
+
+    if (m_isOverlay)
+    {
+        // An unpinned menu floats above the content below it instead of
+        // pushing it down, which would relayout the content twice for every
+        // temporary expansion.
+        m_isFloating = m_isExpanded && !m_isPinned;
+        updateGeometry();
+
+        if (m_isFloating)
+        {
+            raise();
+        }
+
+        resize(width(), height);
+    }
+    else
+    {
+        m_isFloating = false;
+        resize(width(), height);
+        setFixedHeight(height);
+    }
+}
+
+void OfficeMenu::collapseFinished()
+{
+    // The menu keeps its expanded height until the collapse animation ended.
+    if (!m_isExpanded)
+    {
+        updateHeight();
+    }
+}
+
+void OfficeMenu::invalidateKeyTips()
+{
+    // The key tips keep a navigation graph of the headers and the items of the
+    // expanded header, which has to be rebuilt after any of them changed.
+    if (m_keyTips != nullptr)
+    {
+        m_keyTips->invalidate();
+    }
+}
+
+void OfficeMenu::activateItem(OfficeMenuItem* item)
+{
+    revealPanel(item->panel());
+
+    // Triggers the item just like a click would, so that applications do not
+    // have to distinguish between the mouse, key tips and the search field.
+    QWidget* widget = item->widget();
+    widget->setFocus(Qt::ShortcutFocusReason);
+
+    if (auto* button = qobject_cast<QAbstractButton*>(widget))
+    {
+        button->animateClick();
+    }
+}
+
+void OfficeMenu::activateLightItem(OfficeMenuPanel* panel, int id)
+{
+    const int index = panel->lightIndex(id);
+    if (index == -1 || !panel->m_lightItems.at(index).item.isEnabled())
+    {
+        return;
+    }
+
+    revealPanel(panel);
+
+    // Behaves like a click, which either opens the editor of the item or
+    // triggers it.
+    if (panel->m_lightItems.at(index).item.editorFactory())
+    {
+        panel->promoteLightItem(index);
+    }
+    else
+    {
+        panel->triggerLightItem(index);
+    }
+}
+
+void OfficeMenu::revealPanel(OfficeMenuPanel* panel)
+{
+    OfficeMenuHeader* header = panel->header();
+    if (!header->isSelected())
+    {
+        expand(header);
+    }
+
+    // The items of a collapsed panel are hidden until its popup is open. A
+    // hidden item could neither take the focus nor be clicked.
+    if (panel->tier() == OfficeMenuPanel::CollapsedTier)
+    {
+        priv::PanelButton* button = header->m_panelButtons.value(panel);
+        if (button != nullptr)
+        {
+            button->openPopup();
+        }
+    }
+}
@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuCommandIndex.hpp>
+#include <QOffice/Widgets/OfficeMenuItem.hpp>
+#include <QOffice/Widgets/OfficeMenuLightItem.hpp>
+#include <QOffice/Widgets/OfficeMenuPanel.hpp>
+
+#include <QWidget>
+#include <algorithm>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_rankText    = 0)
+OffAnonymous(QOFFICE_CONSTEXPR int c_rankTooltip = 1)
+OffAnonymous(QOFFICE_CONSTEXPR int c_rankPanel   = 2)
+OffAnonymous(QOFFICE_CONSTEXPR int c_rankId      = 3)
+
+priv::CommandIndex::CommandIndex(OfficeMenu* menu)
+    : QObject(menu)
+    , m_generation(0)
+    , m_lastGeneration(-1)
+    , m_stamp(0)
+    , m_sequence(0)
+{
+}
+
+void priv::CommandIndex::insert(OfficeMenuItem* item)
+{
+    OffProfileScope("priv::CommandIndex::insert");
+
+    QWidget* widget = item->widget();
+    if (widget == nullptr || item->panel() == nullptr)
+    {
+        return;
+    }
+
+    Entry entry;
+    tokenize(item->searchText(), c_rankText, entry.tokens);
+    tokenize(widget->toolTip(), c_rankTooltip, entry.tokens);
+    tokenize(QString::number(item->id()), c_rankId, entry.tokens);
+    tokenize(item->panel()->text(), c_rankPanel, entry.tokens);
+
+    // Items might be deleted without being removed from their panel first.
+    insert(qMakePair(item->panel(), item->id()), entry, widget);
+}
+
+void priv::CommandIndex::insert(
+    OfficeMenuPanel* panel, int id,
+    const OfficeMenuLightItem& item
+    )
+{
+    OffProfileScope("priv::CommandIndex::insert");
+
+    Entry entry;
+    tokenize(item.text(), c_rankText, entry.tokens);
+    tokenize(item.toolTip(), c_rankTooltip, entry.tokens);
+    tokenize(QString::number(id), c_rankId, entry.tokens);
+    tokenize(panel->text(), c_rankPanel, entry.tokens);
+
+    // Light items are deleted along with their panel.
+    insert(qMakePair(panel, id), entry, panel);
+}
+
+void priv::CommandIndex::insert(const Key& key, Entry& entry, QObject* owner)
+{
+    remove(key.first, key.second);
+
+    entry.key = key;
+    entry.sequence = m_sequence++;
+    entry.connection = QObject::connect(owner, &QObject::destroyed, this,
+        [this, key]()
+        {
+            remove(key.first, key.second);
+        });
+
+    // Slots of removed items are reused, so the marks never grow unbounded.
+    int slot;
+    if (!m_freeSlots.isEmpty())
+    {
+        slot = m_freeSlots.takeLast();
+        m_entries[slot] = entry;
+    }
+    else
+    {
+        slot = m_entries.size();
+        m_entries.append(entry);
+        m_marks.append(0);
+    }
+
+    for (const Token& token : entry.tokens)
+    {
+        QVector<int>& slots = m_tokens[token.text];
+        if (!slots.contains(slot))
+        {
+            slots.append(slot);
+        }
+    }
+
+    m_slots.insert(key, slot);
+    m_generation++;
+}
+
+void priv::CommandIndex::remove(OfficeMenuPanel* panel, int id)
+{
+    const auto found = m_slots.find(qMakePair(panel, id));
+    if (found == m_slots.end())
+    {
+        return;
+    }
+
+    const int slot = found.value();
+    m_slots.erase(found);
+
+    // Only the tokens of this entry are touched, the rest of the index stays.
+    for (const Token& token : m_entries.at(slot).tokens)
+    {
+        auto slots = m_tokens.find(token.text);
+        if (slots != m_tokens.end())
+        {
+            slots.value().removeOne(slot);
+            if (slots.value().isEmpty())
+            {
+                m_tokens.erase(slots);
+            }
+        }
+    }
+
+    QObject::disconnect(m_entries.at(slot).connection);
+
+    m_entries[slot] = Entry();
+    m_freeSlots.append(slot);
+    m_generation++;
+}
+
+QList<priv::CommandIndex::Key> priv::CommandIndex::find(const QString& query, int maximum)
+{
+    OffProfileScope("priv::CommandIndex::find");
+
+    QVector<Token> words;
+    tokenize(query, 0, words);
+
+    QVector<int> candidates;
+    if (words.isEmpty())
+    {
+        m_lastWords.clear();
+        return QList<Key>();
+    }
+
+    if (m_lastGeneration == m_generation && refines(words, m_lastWords))
+    {
+        // Typing one more character can only narrow the previous matches.
+        candidates = m_lastMatches;
+    }
+    else
+    {
+        // The longest word is the most selective one. Its candidates are read
+        // from the sorted token map, all other words are checked afterwards.
+        const Token* driver = &words.first();
+        for (const Token& word : words)
+        {
+            if (word.text.size() > driver->text.size())
+            {
+                driver = &word;
+            }
+        }
+
+        m_stamp++;
+
+        auto it = m_tokens.lowerBound(driver->text);
+        for (; it != m_tokens.end() && it.key().startsWith(driver->text); ++it)
+        {
+            for (int slot : it.value())
+            {
+                if (m_marks.at(slot) != m_stamp)
+                {
+                    m_marks[slot] = m_stamp;
+                    candidates.append(slot);
+                }
+            }
+        }
+    }
+
+    QVector<QPair<int,int>> matches;
+    matches.reserve(candidates.size());
+    m_lastMatches.clear();
+
+    for (int slot : candidates)
+    {
+        const int rank = score(m_entries.at(slot), words);
+        if (rank >= 0)
+        {
+            matches.append(qMakePair(rank, slot));
+            m_lastMatches.append(slot);
+        }
+    }
+
+    m_lastWords = words;
+    m_lastGeneration = m_generation;
+
+    // Matches in the item text come first, then the ones in the tooltip and so
+    // on. Equally ranked items keep the order of their insertion, which is not
+    // the order of their slots, since the slots of removed items are reused.
+    std::sort(matches.begin(), matches.end(),
+        [this](const QPair<int,int>& a, const QPair<int,int>& b)
+        {
+            if (a.first != b.first)
+            {
+                return a.first < b.first;
+            }
+
+            return m_entries.at(a.second).sequence < m_entries.at(b.second).sequence;
+        });
+
+    QList<Key> result;
+    for (const auto& match : matches)
+    {
+        if (maximum >= 0 && result.size() >= maximum)
+        {
+            break;
+        }
+
+        result.append(m_entries.at(match.second).key);
+    }
+
+    return result;
+}
+
+void priv::CommandIndex::tokenize(const QString& text, int rank, QVector<Token>& tokens)
+{
+    QString current;
+    for (const QChar c : text)
+    {
+        if (c.isLetterOrNumber())
+        {
+            current.append(c.toCaseFolded());
+        }
+        else if (c != QLatin1Char('&') && !current.isEmpty())
+        {
+            // Ampersands of mnemonics do not separate words, e.g. "&Bold".
+            tokens.append({ current, rank });
+            current.clear();
+        }
+    }
+
+    if (!current.isEmpty())
+    {
+        tokens.append({ current, rank });
+    }
+}
+
+int priv::CommandIndex::score(const Entry& entry, const QVector<Token>& words)
+{
+    // Every word has to be the prefix of at least one token of the entry. The
+    // score is the sum of the best ranks, lower scores are better matches.
+    int total = 0;
+    for (const Token& word : words)
+    {
+        int best = -1;
+        for (const Token& token : entry.tokens)
+        {
+            if ((best == -1 || token.rank < best) && token.text.startsWith(word.text))
+            {
+                best = token.rank;
+            }
+        }
+
+        if (best == -1)
+        {
+            return -1;
+        }
+
+        total += best;
+    }
+
+    return total;
+}
+
+bool priv::CommandIndex::refines(const QVector<Token>& words, const QVector<Token>& previous)
+{
+    if (previous.isEmpty() || words.size() < previous.size())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < previous.size(); ++i)
+    {
+        if (!words.at(i).text.startsWith(previous.at(i).text))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
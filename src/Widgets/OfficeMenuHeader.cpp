@@ -21,17 +21,22 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <QOffice/Design/OfficeAccent.hpp>
+#include <QOffice/Design/OfficeAnimationClock.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 #include <QOffice/Widgets/OfficeMenu.hpp>
 #include <QOffice/Widgets/OfficeMenuHeader.hpp>
 #include <QOffice/Widgets/OfficeMenuPanel.hpp>
 #include <QOffice/Widgets/OfficeMenuPanelBar.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelButton.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelSnapshot.hpp>
 #include <QOffice/Widgets/OfficeMenuPinButton.hpp>
 
-#include <QGraphicsEffect>
 #include <QHBoxLayout>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QTimer>
 
 OffAnonymous(QOFFICE_CONSTEXPR int c_headerHeight = 30)
 OffAnonymous(QOFFICE_CONSTEXPR int c_panelHeight  = 90)
@@ -43,13 +48,15 @@ OfficeMenuHeader::OfficeMenuHeader(OfficeMenu* parent)
     , m_parent(parent)
     , m_panelBar(new priv::PanelBar(parent))
     , m_panelLayout(new QHBoxLayout)
-    , m_effectIn(new QGraphicsOpacityEffect(m_panelBar))
-    , m_animationIn(new QPropertyAnimation(m_panelBar, "size"))
-    , m_animationOut(new QPropertyAnimation(m_panelBar, "size"))
+    , m_snapshot(new priv::PanelSnapshot(parent))
+    , m_pinButton(new priv::PinButton(this))
+    , m_animationIn(0)
+    , m_animationOut(0)
     , m_text("Header")
     , m_isHovered(false)
     , m_isSelected(false)
     , m_id(-1)
+    , m_tierWidth(-1)
 {
     // Split the layout up into two separate layouts. This is needed for the
     // sticky button to always stay on the bottom right.
@@ -63,7 +70,7 @@ OfficeMenuHeader::OfficeMenuHeader(OfficeMenu* parent)
     buttonLayout->setMargin(0);
     buttonLayout->setContentsMargins(0,0,0,0);
     buttonLayout->setSizeConstraint(QLayout::SetFixedSize);
-    buttonLayout->addWidget(new priv::PinButton(this), 0, Qt::AlignBottom);
+    buttonLayout->addWidget(m_pinButton, 0, Qt::AlignBottom);
 
     QSpacerItem* spacer = new QSpacerItem(
         c_space, 0,
@@ -71,8 +78,10 @@ OfficeMenuHeader::OfficeMenuHeader(OfficeMenu* parent)
         QSizePolicy::Expanding
         );
 
+    // The header fills its entire area, depending on its state.
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
     m_panelBar->hide();
-    m_panelBar->setGraphicsEffect(m_effectIn);
     m_panelBar->setAutoFillBackground(true);
     m_panelBar->setLayout(stickyLayout);
     m_panelBar->resize(0, 0);
@@ -84,20 +93,6 @@ OfficeMenuHeader::OfficeMenuHeader(OfficeMenu* parent)
     stickyLayout->addLayout(m_panelLayout);
     stickyLayout->addSpacerItem(spacer);
     stickyLayout->addLayout(buttonLayout);
-
-    QObject::connect(
-        m_animationIn,
-        &QPropertyAnimation::finished,
-        this,
-        &OfficeMenuHeader::animationInFinished
-        );
-
-    QObject::connect(
-        m_animationOut,
-        &QPropertyAnimation::finished,
-        this,
-        &OfficeMenuHeader::animationOutFinished
-        );
 }
 
 int OfficeMenuHeader::id() const
@@ -173,6 +168,8 @@ OfficeMenuPanel* OfficeMenuHeader::insertPanel(int pos, int id, const QString& t
 
     m_panels.insert(pos, panel);
     m_panelLayout->insertWidget(pos, panel, 0);
+    m_parent->invalidateKeyTips();
+    invalidateTiers();
 
     return panel;
 }
@@ -184,8 +181,13 @@ bool OfficeMenuHeader::removePanel(int id)
     {
         m_panels.removeOne(panel);
         m_panelLayout->removeWidget(panel);
+        m_parent->invalidateKeyTips();
 
+        // Deleting the button moves the panel out of its popup, if open.
+        delete m_panelButtons.take(panel);
         delete panel;
+
+        invalidateTiers();
     }
 
     return panel != nullptr;
@@ -198,6 +200,8 @@ QSize OfficeMenuHeader::sizeHint() const
 
 void OfficeMenuHeader::paintEvent(QPaintEvent*)
 {
+    OffProfileScope("OfficeMenuHeader::paintEvent");
+
     QPainter painter(this);
 
     const QColor& colorAccent = OfficeAccent::color(m_parent->accent());
@@ -208,17 +212,17 @@ void OfficeMenuHeader::paintEvent(QPaintEvent*)
     // Background
     if (m_isSelected)
     {
-        painter.fillRect(background, colorBackg);
+        painter.fillRect(rect(), colorBackg);
         painter.setPen(colorAccent);
     }
     else if (m_isHovered)
     {
-        painter.fillRect(background, colorLight);
+        painter.fillRect(rect(), colorLight);
         painter.setPen(colorBackg);
     }
     else
     {
-        painter.fillRect(background, colorAccent);
+        painter.fillRect(rect(), colorAccent);
         painter.setPen(colorBackg);
     }
 
@@ -228,16 +232,14 @@ void OfficeMenuHeader::paintEvent(QPaintEvent*)
 
 void OfficeMenuHeader::enterEvent(QEvent* event)
 {
-    m_isHovered = true;
-    update();
+    setHovered(true);
 
     QWidget::enterEvent(event);
 }
 
 void OfficeMenuHeader::leaveEvent(QEvent* event)
 {
-    m_isHovered = false;
-    update();
+    setHovered(false);
 
     QWidget::leaveEvent(event);
 }
@@ -250,46 +252,73 @@ void OfficeMenuHeader::mousePressEvent(QMouseEvent* event)
     }
 }
 
+void OfficeMenuHeader::setHovered(bool hovered)
+{
+    // Flat hover states never repaint the header when the mouse passes by.
+    hovered = hovered && OfficePerformance::isHoverEnabled();
+    if (m_isHovered != hovered)
+    {
+        m_isHovered = hovered;
+
+        // The selected header looks the same, whether it is hovered or not.
+        if (!m_isSelected)
+        {
+            update();
+        }
+    }
+}
+
 void OfficeMenuHeader::animationInFinished()
 {
+    // Swaps the live widgets back in, they have been laid out already.
+    m_panelBar->show();
+    m_snapshot->release();
 }
 
 void OfficeMenuHeader::animationOutFinished()
 {
-    m_parent->resize(width(), c_headerHeight);
-    m_parent->setFixedHeight(c_headerHeight);
+    m_snapshot->release();
+    m_parent->collapseFinished();
 }
 
 void OfficeMenuHeader::expand(QHBoxLayout* panel, bool isExpanded)
 {
     panel->addWidget(m_panelBar, 0, Qt::AlignLeft);
 
-    if (!isExpanded)
-    {
-        // Huge hack: QWidget::show appearantly resizes the widget immediately,
-        // no matter what I do. Even explicit calls to QWidget::resize or
-        // QWidget::updateGeometry failed. This behaviour caused the widget to
-        // be visible at full height for a split second, before the QProperty-
-        // Animation kicked in and changed the QWidget::height to zero.
-        m_effectIn->setOpacity(0.0);
-        m_panelBar->show();
-
-        // This undesirable effect can only be eliminated by hiding the widget
-        // visually (via QGraphicsOpacityEffect) for a split second, too.
-        QTimer::singleShot(100, [&]() { m_effectIn->setOpacity(1.0); });
+    // Chooses the panel tiers before the panel bar is laid out or captured.
+    m_isSelected = true;
+    updateTiers(m_parent->width());
 
-        // The menu is not pinned yet, therefore show it using an animation.
-        m_animationIn->setDuration(200);
-        m_animationIn->setStartValue(QSize(m_parent->width(), 0));
-        m_animationIn->setEndValue(QSize(m_parent->width(), c_panelHeight));
-        m_animationIn->start();
+    if (!isExpanded && OfficePerformance::isAnimationEnabled())
+    {
+        OfficeAnimationClock::stop(m_animationOut);
+
+        // Instead of resizing the panel bar, which lays out every panel and
+        // item once per frame, the bar is laid out and rendered only once at
+        // its final size. The animation merely reveals that snapshot, the
+        // live bar stays hidden until it finished.
+        m_panelBar->setGeometry(0, c_headerHeight, m_parent->width(), c_panelHeight);
+        m_snapshot->capture(m_panelBar);
+        m_snapshot->setGeometry(0, c_headerHeight, m_parent->width(), 0);
+        m_snapshot->show();
+
+        // The menu is not pinned yet, therefore show it using an animation. It
+        // is cancelled along with this header, the snapshot outlives it.
+        const int width = m_parent->width();
+        m_animationIn = OfficeAnimationClock::start(
+            this,
+            200,
+            [this, width](qreal progress)
+            {
+                m_snapshot->resize(width, qRound(c_panelHeight * progress));
+            },
+            [this]() { animationInFinished(); });
     }
     else
     {
         m_panelBar->show();
     }
 
-    m_isSelected = true;
     update();
 
     emit headerExpanded();
@@ -299,17 +328,52 @@ void OfficeMenuHeader::collapse(QHBoxLayout* panel, bool isExpanded)
 {
     panel->removeWidget(m_panelBar);
 
-    if (isExpanded && m_isSelected)
+    const bool isShown = isExpanded && m_isSelected;
+    const bool animate = isShown && OfficePerformance::isAnimationEnabled();
+
+    // Collapsing in the middle of the expansion continues from the current
+    // height of the snapshot, which is still up to date.
+    int height = c_panelHeight;
+    if (OfficeAnimationClock::isRunning(m_animationIn))
+    {
+        OfficeAnimationClock::stop(m_animationIn);
+        height = m_snapshot->height();
+    }
+    else if (animate)
+    {
+        m_snapshot->capture(m_panelBar);
+    }
+
+    m_panelBar->hide();
+
+    if (animate)
     {
         // Hides the menu using a smooth animation.
-        m_animationOut->setDuration(200);
-        m_animationOut->setStartValue(QSize(m_parent->width(), c_panelHeight));
-        m_animationOut->setEndValue(QSize(m_parent->width(), 0));
-        m_animationOut->start();
+        m_snapshot->setGeometry(0, c_headerHeight, m_parent->width(), height);
+        m_snapshot->show();
+
+        const int width = m_parent->width();
+        m_animationOut = OfficeAnimationClock::start(
+            this,
+            200 * height / c_panelHeight,
+            [this, width, height](qreal progress)
+            {
+                m_snapshot->resize(width, qRound(height * (1.0 - progress)));
+            },
+            [this]() { animationOutFinished(); });
     }
     else
     {
-        m_panelBar->hide();
+        // A previous collapse must not shrink the menu once another header
+        // has been expanded in the meantime.
+        OfficeAnimationClock::stop(m_animationOut);
+        m_snapshot->release();
+
+        // Without an animation, the menu shrinks right away.
+        if (isShown)
+        {
+            m_parent->collapseFinished();
+        }
     }
 
     m_isSelected = false;
@@ -317,3 +381,112 @@ void OfficeMenuHeader::collapse(QHBoxLayout* panel, bool isExpanded)
 
     emit headerCollapsed();
 }
+
+void OfficeMenuHeader::updateTiers(int width)
+{
+    // The tiers of the panels are only chosen again if the width changed or
+    // any panel changed its contents. Hidden headers are updated on expand.
+    if (!m_isSelected || width == m_tierWidth)
+    {
+        return;
+    }
+
+    OffProfileScope("OfficeMenuHeader::updateTiers");
+
+    m_tierWidth = width;
+    if (m_panels.isEmpty())
+    {
+        return;
+    }
+
+    const int spacing = m_panelLayout->spacing();
+    const int available = width - m_pinButton->sizeHint().width() - spacing * 2;
+
+    QVector<int> tiers(m_panels.size(), OfficeMenuPanel::LargeTier);
+    int total = spacing * (m_panels.size() - 1);
+
+    for (auto* panel : m_panels)
+    {
+        total += panel->tierWidth(OfficeMenuPanel::LargeTier);
+    }
+
+    // Greedily shrinks the panels from right to left, one tier at a time,
+    // like Office does. Only the widths memoised by the panels are summed,
+    // nothing is measured while resizing.
+    for (int tier = OfficeMenuPanel::MediumTier;
+         tier <= OfficeMenuPanel::CollapsedTier && total > available;
+         ++tier)
+    {
+        for (int i = m_panels.size() - 1; i >= 0 && total > available; --i)
+        {
+            const auto next = static_cast<OfficeMenuPanel::Tier>(tier);
+            const auto current = static_cast<OfficeMenuPanel::Tier>(tiers.at(i));
+            const int saved =
+                m_panels.at(i)->tierWidth(current) -
+                m_panels.at(i)->tierWidth(next);
+
+            if (saved > 0)
+            {
+                total -= saved;
+                tiers[i] = tier;
+            }
+        }
+    }
+
+    for (int i = 0; i < m_panels.size(); ++i)
+    {
+        applyTier(m_panels.at(i), tiers.at(i));
+    }
+}
+
+void OfficeMenuHeader::invalidateTiers()
+{
+    if (m_tierWidth == -1)
+    {
+        return;
+    }
+
+    m_tierWidth = -1;
+
+    // Deferred, so that inserting many items measures every panel only once.
+    if (m_isSelected)
+    {
+        QTimer::singleShot(0, this, [this]() { updateTiers(m_parent->width()); });
+    }
+}
+
+void OfficeMenuHeader::applyTier(OfficeMenuPanel* panel, int tier)
+{
+    const bool wasCollapsed = panel->tier() == OfficeMenuPanel::CollapsedTier;
+    const bool isCollapsed = tier == OfficeMenuPanel::CollapsedTier;
+
+    panel->setTier(static_cast<OfficeMenuPanel::Tier>(tier));
+
+    if (isCollapsed && !wasCollapsed)
+    {
+        // Collapsed panels are replaced by a button that shows them in a popup.
+        priv::PanelButton*& button = m_panelButtons[panel];
+        if (button == nullptr)
+        {
+            button = new priv::PanelButton(panel, m_panelBar);
+        }
+
+        m_panelLayout->replaceWidget(panel, button);
+        panel->hide();
+        button->show();
+    }
+    else if (!isCollapsed && wasCollapsed)
+    {
+        priv::PanelButton* button = m_panelButtons.value(panel);
+        button->closePopup();
+
+        m_panelLayout->replaceWidget(button, panel);
+        button->hide();
+        panel->show();
+    }
+
+    if (isCollapsed != wasCollapsed)
+    {
+        m_parent->invalidateKeyTips();
+    }
+}
@@ -26,6 +26,7 @@
 #include <QOffice/Widgets/OfficeMenuItem.hpp>
 #include <QOffice/Widgets/OfficeMenuPanel.hpp>
 
+#include <QAbstractButton>
 #include <QApplication>
 
 int OfficeMenuItem::id() const
@@ -48,6 +49,29 @@ void OfficeMenuItem::setPanel(OfficeMenuPanel* panel)
     m_parent = panel;
 }
 
+QByteArray OfficeMenuItem::saveState() const
+{
+    return QByteArray();
+}
+
+bool OfficeMenuItem::restoreState(const QByteArray&)
+{
+    return false;
+}
+
+QString OfficeMenuItem::searchText()
+{
+    QWidget* item = widget();
+    QAbstractButton* button = qobject_cast<QAbstractButton*>(item);
+
+    if (button != nullptr && !button->text().isEmpty())
+    {
+        return button->text();
+    }
+
+    return (item != nullptr) ? item->accessibleName() : QString();
+}
+
 void OfficeMenuItem::emitItemEvent(OfficeMenuEvent* event)
 {
     // Climbs up the hierarchy latter and forwards the event.
@@ -0,0 +1,744 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QOffice/Design/OfficeAccent.hpp>
+#include <QOffice/Design/OfficeFont.hpp>
+#include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuHeader.hpp>
+#include <QOffice/Widgets/OfficeMenuItem.hpp>
+#include <QOffice/Widgets/OfficeMenuKeyTips.hpp>
+#include <QOffice/Widgets/OfficeMenuPanel.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelButton.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelLayout.hpp>
+
+#include <QApplication>
+#include <QKeyEvent>
+#include <QPainter>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_badgePaddingX = 4)
+OffAnonymous(QOFFICE_CONSTEXPR int c_badgePaddingY = 1)
+OffAnonymous(QOFFICE_CONSTEXPR int c_letterCount = 26)
+
+priv::KeyTips::KeyTips(OfficeMenu* menu)
+    : QWidget(menu)
+    , m_menu(menu)
+    , m_currentLight(-1)
+    , m_level(HeaderLevel)
+    , m_firstItem(-1)
+    , m_isActive(false)
+    , m_isGraphValid(false)
+    , m_isAltPending(false)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+    setFont(OfficeFont::font(OfficeFont::Semibold, OfficeFont::Small));
+    hide();
+
+    // Alt is tapped while any widget of the window has the focus, therefore
+    // the key events are watched application-wide.
+    qApp->installEventFilter(this);
+}
+
+bool priv::KeyTips::isActive() const
+{
+    return m_isActive;
+}
+
+void priv::KeyTips::activate()
+{
+    if (m_isActive || !m_menu->isVisible() || m_menu->m_headers.isEmpty())
+    {
+        return;
+    }
+
+    m_isActive = true;
+    m_level = HeaderLevel;
+    m_typed.clear();
+
+    // The focus moves to the menu while navigating and is given back once the
+    // key tips are dismissed with the escape key.
+    m_previousFocus = QApplication::focusWidget();
+    m_menu->setFocus(Qt::ShortcutFocusReason);
+
+    if (!m_isGraphValid)
+    {
+        updateGraph();
+    }
+
+    // Starts at the expanded header, if any.
+    int start = 0;
+    for (int i = 0; i < m_nodes.size(); ++i)
+    {
+        if (isHeader(m_nodes.at(i)) && m_nodes.at(i).header->isSelected())
+        {
+            start = i;
+        }
+    }
+
+    setCurrent(start);
+    setGeometry(m_menu->rect());
+    raise();
+    show();
+}
+
+void priv::KeyTips::deactivate(bool restoreFocus)
+{
+    if (!m_isActive)
+    {
+        return;
+    }
+
+    m_isActive = false;
+    m_typed.clear();
+    hide();
+
+    if (restoreFocus && !m_previousFocus.isNull())
+    {
+        m_previousFocus->setFocus(Qt::ShortcutFocusReason);
+    }
+
+    m_previousFocus = nullptr;
+}
+
+void priv::KeyTips::invalidate()
+{
+    // The graph is rebuilt lazily, so a series of insertions costs nothing.
+    m_isGraphValid = false;
+
+    if (m_isActive)
+    {
+        update();
+    }
+}
+
+void priv::KeyTips::paintEvent(QPaintEvent*)
+{
+    OffProfileScope("priv::KeyTips::paintEvent");
+
+    const int current = currentNode();
+    const QFontMetrics metrics(font());
+
+    QPainter painter(this);
+    painter.setFont(font());
+
+    // Current node
+    if (current != -1)
+    {
+        painter.setPen(OfficeAccent::darkColor(m_menu->accent()));
+        painter.drawRect(nodeRect(m_nodes.at(current)).adjusted(0,0,-1,-1));
+    }
+
+    // Badges
+    for (const Node& node : m_nodes)
+    {
+        if (isHeader(node) == (m_level == ItemLevel) ||
+            node.tip.isEmpty() ||
+            !node.tip.startsWith(m_typed) ||
+            !node.widget->isVisible())
+        {
+            continue;
+        }
+
+        // The badge is centered below the node, but may not leave the menu.
+        const QRect area = nodeRect(node);
+        QRect badge(
+            0, 0,
+            metrics.width(node.tip) + c_badgePaddingX * 2,
+            metrics.height() + c_badgePaddingY * 2
+            );
+
+        badge.moveCenter(QPoint(area.center().x(), area.bottom()));
+        badge.moveLeft(qBound(0, badge.left(), width() - badge.width()));
+        badge.moveTop(qBound(0, badge.top(), height() - badge.height()));
+
+        painter.fillRect(badge, OfficePalette::color(OfficePalette::TooltipBackground));
+        painter.setPen(OfficePalette::color(OfficePalette::TooltipBorder));
+        painter.drawRect(badge.adjusted(0,0,-1,-1));
+        painter.setPen(OfficePalette::color(OfficePalette::TooltipText));
+        painter.drawText(badge, node.tip, QTextOption(Qt::AlignCenter));
+    }
+}
+
+bool priv::KeyTips::eventFilter(QObject* obj, QEvent* event)
+{
+    // Every event of the application passes through here, hence each case is
+    // rejected as early and as cheaply as possible.
+    switch (event->type())
+    {
+    case QEvent::ShortcutOverride:
+        // Accepting the override keeps the shortcuts of the application from
+        // consuming the letters of the key tips.
+        if (m_isActive && belongsToWindow(obj))
+        {
+            event->accept();
+            return true;
+        }
+        break;
+
+    case QEvent::KeyPress:
+        if (belongsToWindow(obj))
+        {
+            auto* keyEvent = static_cast<QKeyEvent*>(event);
+            if (keyEvent->key() == Qt::Key_Alt)
+            {
+                if (!keyEvent->isAutoRepeat())
+                {
+                    m_isAltPending = true;
+                }
+
+                break;
+            }
+
+            // Alt is only a tap if no other key is pressed in between.
+            m_isAltPending = false;
+
+            if (m_isActive)
+            {
+                return keyPress(keyEvent);
+            }
+        }
+        break;
+
+    case QEvent::KeyRelease:
+        if (m_isAltPending &&
+            static_cast<QKeyEvent*>(event)->key() == Qt::Key_Alt &&
+            belongsToWindow(obj))
+        {
+            m_isAltPending = false;
+
+            if (m_isActive)
+            {
+                deactivate(true);
+            }
+            else
+            {
+                activate();
+            }
+
+            return true;
+        }
+        break;
+
+    case QEvent::MouseButtonPress:
+        m_isAltPending = false;
+
+        if (m_isActive)
+        {
+            deactivate(false);
+        }
+        break;
+
+    case QEvent::Resize:
+        if (m_isActive && obj == m_menu)
+        {
+            setGeometry(m_menu->rect());
+        }
+        break;
+
+    case QEvent::WindowDeactivate:
+        if (m_isActive && obj == m_menu->window())
+        {
+            deactivate(false);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return QWidget::eventFilter(obj, event);
+}
+
+bool priv::KeyTips::isHeader(const Node& node)
+{
+    // Items and panel buttons are placed below the header they belong to.
+    return node.widget == node.header;
+}
+
+void priv::KeyTips::updateGraph()
+{
+    OffProfileScope("priv::KeyTips::updateGraph");
+
+    m_nodes.clear();
+    m_nodeIndex.clear();
+    m_firstItem = -1;
+
+    // Headers form a single row and simply link to their neighbours.
+    OfficeMenuHeader* expanded = nullptr;
+    int expandedIndex = -1;
+
+    const int headerCount = m_menu->m_headers.size();
+    for (int i = 0; i < headerCount; ++i)
+    {
+        OfficeMenuHeader* header = m_menu->m_headers.at(i);
+        Node node = { header, header, nullptr, nullptr, -1, QString(), qreal(i), -1, { -1, -1, -1, -1 } };
+
+        node.next[Left]  = (i > 0) ? i - 1 : -1;
+        node.next[Right] = (i < headerCount - 1) ? i + 1 : -1;
+
+        if (header->isSelected())
+        {
+            expanded = header;
+            expandedIndex = i;
+        }
+
+        m_nodes.append(node);
+    }
+
+    // Only the items of the expanded header are reachable. They are placed by
+    // their grid cells rather than by their geometry, so the graph does not
+    // depend on the panel bar being laid out or animated. The columns of all
+    // panels are concatenated into one large grid.
+    if (expanded != nullptr)
+    {
+        int column = 0;
+        for (auto* panel : expanded->m_panels)
+        {
+            priv::PanelLayout* grid = panel->m_layout;
+
+            // The items of a collapsed panel are hidden, the button that shows
+            // them in a popup takes their place instead.
+            if (panel->tier() == OfficeMenuPanel::CollapsedTier)
+            {
+                priv::PanelButton* button = expanded->m_panelButtons.value(panel);
+                if (button != nullptr)
+                {
+                    Node node =
+                    {
+                        button, expanded, nullptr, button, -1, QString(),
+                        qreal(column),
+                        (grid->rowCount() - 1) / 2.0,
+                        { -1, -1, -1, -1 }
+                    };
+
+                    m_nodes.append(node);
+                    column += 1;
+                }
+
+                continue;
+            }
+
+            for (auto* item : panel->m_items)
+            {
+                const int index = grid->indexOf(item->widget());
+                if (index < 0)
+                {
+                    continue;
+                }
+
+                int row, col, rowSpan, colSpan;
+                grid->getItemPosition(index, &row, &col, &rowSpan, &colSpan);
+
+                Node node =
+                {
+                    item->widget(), expanded, item, nullptr, -1, QString(),
+                    column + col + (colSpan - 1) / 2.0,
+                    row + (rowSpan - 1) / 2.0,
+                    { -1, -1, -1, -1 }
+                };
+
+                m_nodes.append(node);
+            }
+
+            // Light items have no widget of their own, they are told apart by
+            // their ID within the panel that paints them.
+            for (const auto& slot : panel->m_lightItems)
+            {
+                Node node =
+                {
+                    panel, expanded, nullptr, nullptr, slot.id, QString(),
+                    column + slot.column + (slot.columnSpan - 1) / 2.0,
+                    slot.row + (slot.rowSpan - 1) / 2.0,
+                    { -1, -1, -1, -1 }
+                };
+
+                m_nodes.append(node);
+            }
+
+            column += grid->columnCount();
+        }
+
+        linkItems(headerCount, expandedIndex);
+    }
+
+    assignTips(0, headerCount, true);
+    assignTips(headerCount, m_nodes.size(), false);
+
+    for (int i = 0; i < m_nodes.size(); ++i)
+    {
+        m_nodeIndex.insert(qMakePair(m_nodes.at(i).widget, m_nodes.at(i).light), i);
+    }
+
+    m_isGraphValid = true;
+}
+
+void priv::KeyTips::linkItems(int first, int header)
+{
+    // Determines the nearest item in every direction once per layout, so that
+    // each arrow key press is a plain lookup afterwards.
+    for (int i = first; i < m_nodes.size(); ++i)
+    {
+        Node& node = m_nodes[i];
+        qreal best[DirectionCount] = { 0, 0, 0, 0 };
+
+        for (int j = first; j < m_nodes.size(); ++j)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            const qreal dx = m_nodes.at(j).x - node.x;
+            const qreal dy = m_nodes.at(j).y - node.y;
+
+            // Items straight ahead are preferred over closer, but offset ones.
+            const qreal distances[DirectionCount][2] =
+            {
+                { -dx, dy }, { -dy, dx }, { dx, dy }, { dy, dx }
+            };
+
+            for (int d = 0; d < DirectionCount; ++d)
+            {
+                const qreal primary = distances[d][0];
+                if (primary <= 0)
+                {
+                    continue;
+                }
+
+                const qreal score = primary + qAbs(distances[d][1]) * 2;
+                if (node.next[d] == -1 || score < best[d])
+                {
+                    node.next[d] = j;
+                    best[d] = score;
+                }
+            }
+        }
+
+        // The top row of items leads back up to the header.
+        if (node.next[Up] == -1)
+        {
+            node.next[Up] = header;
+        }
+
+        if (m_firstItem == -1 ||
+            node.y < m_nodes.at(m_firstItem).y ||
+           (node.y == m_nodes.at(m_firstItem).y && node.x < m_nodes.at(m_firstItem).x))
+        {
+            m_firstItem = i;
+        }
+    }
+
+    m_nodes[header].next[Down] = m_firstItem;
+}
+
+void priv::KeyTips::assignTips(int first, int last, bool mnemonic)
+{
+    const int count = last - first;
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (count > c_letterCount)
+    {
+        // Two letters each, so that no tip is the prefix of another one.
+        for (int i = first; i < last && i - first < c_letterCount * c_letterCount; ++i)
+        {
+            const int n = i - first;
+            m_nodes[i].tip = QString(QChar('A' + n / c_letterCount)) + QChar('A' + n % c_letterCount);
+        }
+
+        return;
+    }
+
+    QString used;
+
+    // Headers prefer the first free letter of their text, e.g. "H" for "Home".
+    if (mnemonic)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            for (const QChar c : m_nodes.at(i).header->text().toUpper())
+            {
+                if (c >= QLatin1Char('A') && c <= QLatin1Char('Z') && !used.contains(c))
+                {
+                    m_nodes[i].tip = c;
+                    used.append(c);
+                    break;
+                }
+            }
+        }
+    }
+
+    // All other nodes get the remaining letters in alphabetical order.
+    QChar letter = QLatin1Char('A');
+    for (int i = first; i < last; ++i)
+    {
+        if (m_nodes.at(i).tip.isEmpty())
+        {
+            while (used.contains(letter))
+            {
+                letter = QChar(letter.unicode() + 1);
+            }
+
+            m_nodes[i].tip = letter;
+            used.append(letter);
+        }
+    }
+}
+
+bool priv::KeyTips::belongsToWindow(QObject* obj) const
+{
+    return obj->isWidgetType() &&
+           static_cast<QWidget*>(obj)->window() == m_menu->window();
+}
+
+bool priv::KeyTips::keyPress(QKeyEvent* event)
+{
+    switch (event->key())
+    {
+    case Qt::Key_Escape:
+        if (m_level == ItemLevel)
+        {
+            // Goes back to the header of the items.
+            const int current = currentNode();
+            const int header = (current != -1)
+                ? m_nodeIndex.value(QPair<QWidget*,int>(m_nodes.at(current).header, -1), 0)
+                : 0;
+
+            setCurrent(header);
+        }
+        else
+        {
+            deactivate(true);
+        }
+        return true;
+
+    case Qt::Key_Left:  move(Left);  return true;
+    case Qt::Key_Up:    move(Up);    return true;
+    case Qt::Key_Right: move(Right); return true;
+    case Qt::Key_Down:  move(Down);  return true;
+
+    case Qt::Key_Return:
+    case Qt::Key_Enter:
+    case Qt::Key_Space:
+        trigger(currentNode());
+        return true;
+
+    case Qt::Key_Backspace:
+        m_typed.chop(1);
+        update();
+        return true;
+
+    default:
+        break;
+    }
+
+    const QString text = event->text().toUpper();
+    if (text.size() == 1 && text.at(0) >= QLatin1Char('A') && text.at(0) <= QLatin1Char('Z'))
+    {
+        typeTip(text);
+    }
+
+    // Any other key is swallowed, it would otherwise end up in the document
+    // while the user believes to be typing key tips.
+    return true;
+}
+
+void priv::KeyTips::typeTip(const QString& text)
+{
+    if (!m_isGraphValid)
+    {
+        updateGraph();
+    }
+
+    m_typed.append(text);
+
+    int match = -1;
+    bool isPrefix = false;
+
+    for (int i = 0; i < m_nodes.size(); ++i)
+    {
+        const Node& node = m_nodes.at(i);
+        if (isHeader(node) == (m_level == ItemLevel))
+        {
+            continue;
+        }
+
+        if (node.tip == m_typed)
+        {
+            match = i;
+        }
+        else if (node.tip.startsWith(m_typed))
+        {
+            isPrefix = true;
+        }
+    }
+
+    if (match != -1)
+    {
+        m_typed.clear();
+        trigger(match);
+    }
+    else if (!isPrefix)
+    {
+        // Unknown tip, the user has to start over.
+        m_typed.clear();
+    }
+
+    update();
+}
+
+void priv::KeyTips::move(Direction direction)
+{
+    const int current = currentNode();
+    if (current == -1)
+    {
+        setCurrent(0);
+        return;
+    }
+
+    const int next = m_nodes.at(current).next[direction];
+    if (next == -1)
+    {
+        return;
+    }
+
+    QWidget* target = m_nodes.at(next).widget;
+    OfficeMenuHeader* header = m_nodes.at(next).header;
+    const int light = m_nodes.at(next).light;
+
+    if (isHeader(m_nodes.at(next)))
+    {
+        m_level = HeaderLevel;
+
+        // Moving across the headers of an expanded menu switches the header,
+        // just like clicking it would. This invalidates the graph.
+        if (isHeader(m_nodes.at(current)) &&
+            m_nodes.at(current).header->isSelected())
+        {
+            m_menu->expand(header);
+        }
+    }
+    else
+    {
+        m_level = ItemLevel;
+    }
+
+    m_current = target;
+    m_currentLight = light;
+    m_typed.clear();
+    update();
+}
+
+void priv::KeyTips::trigger(int index)
+{
+    if (index < 0 || index >= m_nodes.size())
+    {
+        return;
+    }
+
+    // Copied, since expanding a header rebuilds the nodes.
+    QWidget* widget = m_nodes.at(index).widget;
+    OfficeMenuHeader* header = m_nodes.at(index).header;
+    OfficeMenuItem* item = m_nodes.at(index).item;
+    PanelButton* button = m_nodes.at(index).button;
+    const int light = m_nodes.at(index).light;
+
+    if (isHeader(m_nodes.at(index)))
+    {
+        if (!header->isSelected())
+        {
+            m_menu->expand(header);
+        }
+
+        updateGraph();
+
+        setCurrent(m_firstItem != -1 ? m_firstItem : m_nodeIndex.value(qMakePair(widget, -1), 0));
+    }
+    else if (button != nullptr)
+    {
+        // Opens the collapsed panel, just like clicking its button would.
+        deactivate(false);
+        button->openPopup();
+    }
+    else if (light != -1)
+    {
+        deactivate(false);
+        m_menu->activateLightItem(static_cast<OfficeMenuPanel*>(widget), light);
+    }
+    else
+    {
+        deactivate(false);
+        m_menu->activateItem(item);
+    }
+}
+
+void priv::KeyTips::setCurrent(int index)
+{
+    if (index >= 0 && index < m_nodes.size())
+    {
+        // The tips shown are the ones of the kind of the current node.
+        m_current = m_nodes.at(index).widget;
+        m_currentLight = m_nodes.at(index).light;
+        m_level = isHeader(m_nodes.at(index)) ? HeaderLevel : ItemLevel;
+    }
+    else
+    {
+        m_current = nullptr;
+        m_currentLight = -1;
+        m_level = HeaderLevel;
+    }
+
+    m_typed.clear();
+    update();
+}
+
+int priv::KeyTips::currentNode()
+{
+    if (!m_isGraphValid)
+    {
+        updateGraph();
+    }
+
+    return m_nodeIndex.value(qMakePair(m_current.data(), m_currentLight), -1);
+}
+
+QRect priv::KeyTips::nodeRect(const Node& node) const
+{
+    if (node.light != -1)
+    {
+        // Light items occupy the cell of their spacer within the panel.
+        auto* panel = static_cast<OfficeMenuPanel*>(node.widget);
+        const int index = panel->lightIndex(node.light);
+        if (index != -1)
+        {
+            const QRect cell = panel->m_lightItems.at(index).spacer->geometry();
+            return cell.translated(panel->mapTo(m_menu, QPoint()));
+        }
+    }
+
+    return QRect(node.widget->mapTo(m_menu, QPoint()), node.widget->size());
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QOffice/Widgets/OfficeMenuLightItem.hpp>
+
+OfficeMenuLightItem::OfficeMenuLightItem(
+    const QString& text,
+    const QPixmap& icon,
+    Size size
+    )
+    : m_text(text)
+    , m_icon(icon)
+    , m_size(size)
+    , m_isEnabled(true)
+    , m_isToggable(false)
+    , m_isToggled(false)
+{
+}
+
+const QString& OfficeMenuLightItem::text() const
+{
+    return m_text;
+}
+
+const QPixmap& OfficeMenuLightItem::icon() const
+{
+    return m_icon;
+}
+
+const QString& OfficeMenuLightItem::toolTip() const
+{
+    return m_toolTip;
+}
+
+OfficeMenuLightItem::Size OfficeMenuLightItem::size() const
+{
+    return m_size;
+}
+
+bool OfficeMenuLightItem::isEnabled() const
+{
+    return m_isEnabled;
+}
+
+bool OfficeMenuLightItem::isToggable() const
+{
+    return m_isToggable;
+}
+
+bool OfficeMenuLightItem::isToggled() const
+{
+    return m_isToggled;
+}
+
+const OfficeMenuLightItem::EditorFactory& OfficeMenuLightItem::editorFactory() const
+{
+    return m_factory;
+}
+
+void OfficeMenuLightItem::setText(const QString& text)
+{
+    m_text = text;
+}
+
+void OfficeMenuLightItem::setIcon(const QPixmap& icon)
+{
+    m_icon = icon;
+}
+
+void OfficeMenuLightItem::setToolTip(const QString& toolTip)
+{
+    m_toolTip = toolTip;
+}
+
+void OfficeMenuLightItem::setSize(Size size)
+{
+    m_size = size;
+}
+
+void OfficeMenuLightItem::setEnabled(bool enabled)
+{
+    m_isEnabled = enabled;
+}
+
+void OfficeMenuLightItem::setToggable(bool toggable)
+{
+    m_isToggable = toggable;
+}
+
+void OfficeMenuLightItem::setToggled(bool toggled)
+{
+    m_isToggled = toggled;
+}
+
+void OfficeMenuLightItem::setEditorFactory(const EditorFactory& factory)
+{
+    m_factory = factory;
+}
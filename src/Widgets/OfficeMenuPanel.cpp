@@ -21,27 +21,48 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 #include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuCommandIndex.hpp>
+#include <QOffice/Widgets/OfficeMenuEvent.hpp>
 #include <QOffice/Widgets/OfficeMenuItem.hpp>
 #include <QOffice/Widgets/OfficeMenuPanel.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelLayout.hpp>
 #include <QOffice/Widgets/OfficeMenuHeader.hpp>
 
-#include <QGridLayout>
+#include <QHash>
+#include <QHelpEvent>
+#include <QMouseEvent>
 #include <QPainter>
 #include <QTextOption>
+#include <QToolTip>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_smallIcon = 16)
+OffAnonymous(QOFFICE_CONSTEXPR int c_largeIcon = 32)
+OffAnonymous(QOFFICE_CONSTEXPR int c_smallHeight = 20)
+OffAnonymous(QOFFICE_CONSTEXPR int c_largeHeight = 66)
+OffAnonymous(QOFFICE_CONSTEXPR int c_itemPadding = 4)
 
 OfficeMenuPanel::OfficeMenuPanel(QWidget* panelBar, OfficeMenuHeader* header)
     : QWidget(panelBar)
-    , m_layout(new QGridLayout(this))
+    , m_layout(new priv::PanelLayout(this))
     , m_parent(header)
     , m_text("Panel")
     , m_id(-1)
+    , m_tier(LargeTier)
+    , m_hoveredLight(-1)
+    , m_pressedLight(-1)
+    , m_isTierValid(false)
 {
     m_layout->setSpacing(4);
     m_layout->setContentsMargins(4,0,4,18);
 
     setLayout(m_layout);
     setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Preferred);
+
+    // Required for the hover state of light items.
+    setMouseTracking(true);
 }
 
 int OfficeMenuPanel::id() const
@@ -75,6 +96,17 @@ OfficeMenuItem* OfficeMenuPanel::operator [](int id) const
     return itemById(id);
 }
 
+const OfficeMenuLightItem* OfficeMenuPanel::lightItemById(int id) const
+{
+    const int index = lightIndex(id);
+    if (index == -1)
+    {
+        return nullptr;
+    }
+
+    return &m_lightItems.at(index).item;
+}
+
 void OfficeMenuPanel::setId(int id)
 {
     m_id = id;
@@ -83,6 +115,22 @@ void OfficeMenuPanel::setId(int id)
 void OfficeMenuPanel::setText(const QString& text)
 {
     m_text = text;
+    invalidateTiers();
+}
+
+OfficeMenuPanel::Tier OfficeMenuPanel::tier() const
+{
+    return m_tier;
+}
+
+int OfficeMenuPanel::tierWidth(Tier tier) const
+{
+    if (!m_isTierValid)
+    {
+        calculateTiers();
+    }
+
+    return m_tierWidths[tier];
 }
 
 bool OfficeMenuPanel::insertItem(
@@ -91,7 +139,7 @@ bool OfficeMenuPanel::insertItem(
     int rowSpan, int columnSpan
     )
 {
-    if (item->widget() == nullptr || itemById(id) != nullptr)
+    if (item->widget() == nullptr || itemById(id) != nullptr || lightIndex(id) != -1)
     {
         return false;
     }
@@ -103,19 +151,35 @@ bool OfficeMenuPanel::insertItem(
 
     m_items.append(item);
     m_layout->addWidget(item->widget(), row, column, rowSpan, columnSpan);
+    header()->menu()->invalidateKeyTips();
+    header()->menu()->m_commandIndex->insert(item);
+    invalidateTiers();
 
     return true;
 }
 
 bool OfficeMenuPanel::removeItem(int id)
 {
+    const int light = lightIndex(id);
+    if (light != -1)
+    {
+        removeLightItem(light);
+        return true;
+    }
+
     auto* item = itemById(id);
     if (item != nullptr)
     {
         m_items.removeOne(item);
 
         if (item->widget() != nullptr)
+        {
             m_layout->removeWidget(item->widget());
+            header()->menu()->m_commandIndex->remove(this, id);
+        }
+
+        header()->menu()->invalidateKeyTips();
+        invalidateTiers();
 
         delete item;
     }
@@ -123,6 +187,80 @@ bool OfficeMenuPanel::removeItem(int id)
     return item != nullptr;
 }
 
+bool OfficeMenuPanel::insertLightItem(
+    int id, const OfficeMenuLightItem& item,
+    int row, int column,
+    int rowSpan, int columnSpan
+    )
+{
+    if (itemById(id) != nullptr || lightIndex(id) != -1)
+    {
+        return false;
+    }
+
+    const QSize size = lightItemSize(item, m_tier);
+
+    // The spacer reserves the cell of the item, without any widget behind it.
+    LightSlot slot;
+    slot.item = item;
+    slot.spacer = new QSpacerItem(
+        size.width(), size.height(),
+        QSizePolicy::Fixed,
+        QSizePolicy::Fixed
+        );
+    slot.id = id;
+    slot.row = row;
+    slot.column = column;
+    slot.rowSpan = rowSpan;
+    slot.columnSpan = columnSpan;
+
+    m_lightItems.append(slot);
+    m_layout->addItem(slot.spacer, row, column, rowSpan, columnSpan);
+    header()->menu()->invalidateKeyTips();
+    header()->menu()->m_commandIndex->insert(this, id, item);
+    invalidateTiers();
+
+    return true;
+}
+
+bool OfficeMenuPanel::setLightItem(int id, const OfficeMenuLightItem& item)
+{
+    const int index = lightIndex(id);
+    if (index == -1)
+    {
+        return false;
+    }
+
+    LightSlot& slot = m_lightItems[index];
+    const QSize previous = lightItemSize(slot.item, m_tier);
+    const QSize size = lightItemSize(item, m_tier);
+
+    // Toggling keeps the searchable text, only new texts are indexed again.
+    if (item.text() != slot.item.text() || item.toolTip() != slot.item.toolTip())
+    {
+        header()->menu()->m_commandIndex->insert(this, id, item);
+    }
+
+    slot.item = item;
+
+    // Items that keep their size, e.g. when toggled, do not relayout.
+    if (size != previous)
+    {
+        slot.spacer->changeSize(
+            size.width(), size.height(),
+            QSizePolicy::Fixed,
+            QSizePolicy::Fixed
+            );
+
+        m_layout->invalidate();
+        invalidateTiers();
+    }
+
+    update(slot.spacer->geometry());
+
+    return true;
+}
+
 QSize OfficeMenuPanel::sizeHint() const
 {
     auto lhint = m_layout->sizeHint();
@@ -142,8 +280,52 @@ QSize OfficeMenuPanel::sizeHint() const
 
 }
 
-void OfficeMenuPanel::paintEvent(QPaintEvent*)
+bool OfficeMenuPanel::event(QEvent* event)
 {
+    if (event->type() == QEvent::ToolTip)
+    {
+        // Light items have no widget that could show their tooltip.
+        auto* help = static_cast<QHelpEvent*>(event);
+        const int index = lightItemAt(help->pos());
+        QString toolTip;
+
+        if (index != -1)
+        {
+            // Items that only show their icon reveal their text as tooltip.
+            const OfficeMenuLightItem& item = m_lightItems.at(index).item;
+            toolTip = item.toolTip();
+
+            if (toolTip.isEmpty() && isIconOnly(item, m_tier))
+            {
+                toolTip = item.text();
+            }
+        }
+
+        if (!toolTip.isEmpty())
+        {
+            QToolTip::showText(
+                help->globalPos(),
+                toolTip,
+                this,
+                m_lightItems.at(index).spacer->geometry()
+                );
+        }
+        else
+        {
+            QToolTip::hideText();
+            event->ignore();
+        }
+
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+void OfficeMenuPanel::paintEvent(QPaintEvent* event)
+{
+    OffProfileScope("OfficeMenuPanel::paintEvent");
+
     QPainter painter(this);
 
     const QRect textRect = rect().adjusted(0,0,0,-4);
@@ -160,4 +342,339 @@ void OfficeMenuPanel::paintEvent(QPaintEvent*)
     // Separator
     painter.setPen(colorSeparator);
     painter.drawLine(separatorTop, separatorBtm);
+
+    // Light items
+    for (int i = 0; i < m_lightItems.size(); ++i)
+    {
+        if (m_lightItems.at(i).spacer->geometry().intersects(event->rect()))
+        {
+            paintLightItem(painter, i);
+        }
+    }
+}
+
+void OfficeMenuPanel::leaveEvent(QEvent* event)
+{
+    setHoveredLight(-1);
+
+    QWidget::leaveEvent(event);
+}
+
+void OfficeMenuPanel::mouseMoveEvent(QMouseEvent* event)
+{
+    setHoveredLight(lightItemAt(event->pos()));
+
+    QWidget::mouseMoveEvent(event);
+}
+
+void OfficeMenuPanel::mousePressEvent(QMouseEvent* event)
+{
+    const int index = lightItemAt(event->pos());
+    if (event->button() != Qt::LeftButton ||
+        index == -1 ||
+        !m_lightItems.at(index).item.isEnabled())
+    {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    if (m_lightItems.at(index).item.editorFactory())
+    {
+        promoteLightItem(index);
+    }
+    else
+    {
+        m_pressedLight = index;
+        update(m_lightItems.at(index).spacer->geometry());
+    }
+}
+
+void OfficeMenuPanel::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (m_pressedLight == -1)
+    {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+
+    const int pressed = m_pressedLight;
+    m_pressedLight = -1;
+    update(m_lightItems.at(pressed).spacer->geometry());
+
+    // Just like buttons, the item is only triggered if released above it.
+    if (lightItemAt(event->pos()) == pressed)
+    {
+        triggerLightItem(pressed);
+    }
+}
+
+int OfficeMenuPanel::lightIndex(int id) const
+{
+    for (int i = 0; i < m_lightItems.size(); ++i)
+    {
+        if (m_lightItems.at(i).id == id)
+            return i;
+    }
+
+    return -1;
+}
+
+int OfficeMenuPanel::lightItemAt(const QPoint& pos) const
+{
+    for (int i = 0; i < m_lightItems.size(); ++i)
+    {
+        if (m_lightItems.at(i).spacer->geometry().contains(pos))
+            return i;
+    }
+
+    return -1;
+}
+
+QSize OfficeMenuPanel::lightItemSize(const OfficeMenuLightItem& item, Tier tier) const
+{
+    if (isIconOnly(item, tier))
+    {
+        return QSize(c_smallIcon + c_itemPadding * 2, c_smallHeight);
+    }
+
+    const int textWidth = fontMetrics().width(item.text());
+
+    if (isLarge(item, tier))
+    {
+        const int width = qMax(textWidth, c_largeIcon) + c_itemPadding * 2;
+        return QSize(width, c_largeHeight);
+    }
+
+    return QSize(c_smallIcon + textWidth + c_itemPadding * 3, c_smallHeight);
+}
+
+bool OfficeMenuPanel::isLarge(const OfficeMenuLightItem& item, Tier tier)
+{
+    // Collapsed panels show their contents at full size in the popup.
+    return item.size() == OfficeMenuLightItem::Large &&
+        (tier == LargeTier || tier == CollapsedTier);
+}
+
+bool OfficeMenuPanel::isIconOnly(const OfficeMenuLightItem& item, Tier tier)
+{
+    return tier == SmallTier && !item.icon().isNull() && !item.editorFactory();
+}
+
+void OfficeMenuPanel::paintLightItem(QPainter& painter, int index)
+{
+    const OfficeMenuLightItem& item = m_lightItems.at(index).item;
+    const QRect bounds = m_lightItems.at(index).spacer->geometry();
+    const bool isEditor = static_cast<bool>(item.editorFactory());
+
+    // Background
+    if (item.isEnabled() && !isEditor)
+    {
+        if (index == m_pressedLight && index == m_hoveredLight)
+        {
+            painter.fillRect(bounds, OfficePalette::color(OfficePalette::MenuItemPress));
+        }
+        else if (index == m_hoveredLight && OfficePerformance::isHoverEnabled())
+        {
+            painter.fillRect(bounds, OfficePalette::color(OfficePalette::MenuItemHover));
+        }
+        else if (item.isToggled())
+        {
+            painter.fillRect(bounds, OfficePalette::color(OfficePalette::MenuItemFocus));
+        }
+    }
+    else if (isEditor)
+    {
+        // Items with an editor look like the textbox they will turn into.
+        painter.setPen(OfficePalette::color(OfficePalette::MenuSeparator));
+        painter.drawRect(bounds.adjusted(0,0,-1,-1));
+    }
+
+    QRect iconRect;
+    QRect textRect;
+    Qt::Alignment textAlign;
+
+    if (isLarge(item, m_tier))
+    {
+        iconRect = QRect(0, 0, c_largeIcon, c_largeIcon);
+        iconRect.moveTo(bounds.center().x() - c_largeIcon / 2, bounds.top() + c_itemPadding);
+        textRect = bounds.adjusted(0, c_largeIcon + c_itemPadding * 2, 0, 0);
+        textAlign = Qt::AlignHCenter | Qt::AlignTop;
+    }
+    else
+    {
+        iconRect = QRect(0, 0, c_smallIcon, c_smallIcon);
+        iconRect.moveTo(bounds.left() + c_itemPadding, bounds.center().y() - c_smallIcon / 2);
+        textRect = bounds.adjusted(c_smallIcon + c_itemPadding * 2, 0, 0, 0);
+        textAlign = Qt::AlignLeft | Qt::AlignVCenter;
+    }
+
+    // Icon
+    if (!item.icon().isNull())
+    {
+        painter.setOpacity(item.isEnabled() ? 1.0 : 0.5);
+        painter.drawPixmap(iconRect, item.icon());
+        painter.setOpacity(1.0);
+    }
+
+    // Text
+    if (!isIconOnly(item, m_tier))
+    {
+        painter.setPen(OfficePalette::color(item.isEnabled()
+            ? OfficePalette::Foreground
+            : OfficePalette::DisabledText));
+
+        painter.drawText(textRect, item.text(), QTextOption(textAlign));
+    }
+}
+
+void OfficeMenuPanel::removeLightItem(int index)
+{
+    QSpacerItem* spacer = m_lightItems.at(index).spacer;
+
+    update(spacer->geometry());
+    m_layout->removeItem(spacer);
+    header()->menu()->m_commandIndex->remove(this, m_lightItems.at(index).id);
+    header()->menu()->invalidateKeyTips();
+    m_lightItems.remove(index);
+    m_hoveredLight = -1;
+    m_pressedLight = -1;
+    invalidateTiers();
+
+    delete spacer;
+}
+
+void OfficeMenuPanel::triggerLightItem(int index)
+{
+    OfficeMenuLightItem& item = m_lightItems[index].item;
+    if (item.isToggable())
+    {
+        item.setToggled(!item.isToggled());
+        update(m_lightItems.at(index).spacer->geometry());
+    }
+
+    // Slots might remove the item, which is why it is not accessed afterwards.
+    OfficeMenuButtonClickedEvent event(
+        m_lightItems.at(index).id,
+        item.isToggable(),
+        item.isToggled()
+        );
+
+    emit header()->menu()->buttonClickedEvent(&event);
+}
+
+void OfficeMenuPanel::promoteLightItem(int index)
+{
+    // Copied, since the slot is removed before the editor is inserted.
+    const LightSlot slot = m_lightItems.at(index);
+
+    OfficeMenuItem* editor = slot.item.editorFactory()();
+    if (editor == nullptr || editor->widget() == nullptr)
+    {
+        return;
+    }
+
+    removeLightItem(index);
+    insertItem(slot.id, editor, slot.row, slot.column, slot.rowSpan, slot.columnSpan);
+
+    editor->widget()->show();
+    editor->widget()->setFocus(Qt::MouseFocusReason);
+}
+
+void OfficeMenuPanel::setHoveredLight(int index)
+{
+    if (m_hoveredLight == index)
+    {
+        return;
+    }
+
+    // Flat hover states only repaint while an item is pressed, since it looks
+    // pressed only as long as it is hovered.
+    if (OfficePerformance::isHoverEnabled() || m_pressedLight != -1)
+    {
+        if (m_hoveredLight != -1)
+        {
+            update(m_lightItems.at(m_hoveredLight).spacer->geometry());
+        }
+
+        if (index != -1)
+        {
+            update(m_lightItems.at(index).spacer->geometry());
+        }
+    }
+
+    m_hoveredLight = index;
+}
+
+void OfficeMenuPanel::setTier(Tier tier)
+{
+    if (m_tier == tier)
+    {
+        return;
+    }
+
+    m_tier = tier;
+
+    // Only light items adapt to the tier. Item widgets keep their size, the
+    // panel is collapsed as a whole if they do not fit.
+    for (const LightSlot& slot : m_lightItems)
+    {
+        const QSize size = lightItemSize(slot.item, tier);
+        slot.spacer->changeSize(
+            size.width(), size.height(),
+            QSizePolicy::Fixed,
+            QSizePolicy::Fixed
+            );
+    }
+
+    m_layout->invalidate();
+    updateGeometry();
+    update();
+}
+
+void OfficeMenuPanel::invalidateTiers()
+{
+    m_isTierValid = false;
+    m_parent->invalidateTiers();
+}
+
+void OfficeMenuPanel::calculateTiers() const
+{
+    OffProfileScope("OfficeMenuPanel::calculateTiers");
+
+    // The widths of all tiers are measured once whenever the contents change.
+    // Resizing the menu only sums up these widths and never measures again.
+    QHash<QLayoutItem*, const OfficeMenuLightItem*> lights;
+    for (const LightSlot& slot : m_lightItems)
+    {
+        lights.insert(slot.spacer, &slot.item);
+    }
+
+    const int textWidth = fontMetrics().width(m_text) + 16;
+
+    for (int tier = LargeTier; tier < CollapsedTier; ++tier)
+    {
+        QVector<QSize> hints;
+        hints.reserve(m_layout->count());
+
+        for (int i = 0; i < m_layout->count(); ++i)
+        {
+            QLayoutItem* item = m_layout->itemAt(i);
+            const OfficeMenuLightItem* light = lights.value(item, nullptr);
+
+            if (light != nullptr)
+            {
+                hints.append(lightItemSize(*light, static_cast<Tier>(tier)));
+            }
+            else
+            {
+                hints.append(priv::PanelLayout::isSkipped(item) ? QSize() : item->sizeHint());
+            }
+        }
+
+        m_tierWidths[tier] = qMax(m_layout->sizeHint(hints).width(), textWidth);
+    }
+
+    // A collapsed panel is a single button that shows the panel text.
+    m_tierWidths[CollapsedTier] = textWidth;
+    m_isTierValid = true;
 }
@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/OfficeMenuPanel.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelButton.hpp>
+
+#include <QHBoxLayout>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QTextOption>
+
+OffAnonymous(QOFFICE_CONSTEXPR int c_arrowSize = 4)
+
+priv::PanelButton::PanelButton(OfficeMenuPanel* panel, QWidget* parent)
+    : QWidget(parent)
+    , m_panel(panel)
+    , m_popup(nullptr)
+    , m_isHovered(false)
+{
+    setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
+    setProperty("qoffice_menu_item", true);
+}
+
+priv::PanelButton::~PanelButton()
+{
+    // The panel lives in the popup while it is open and must not be deleted
+    // along with it.
+    closePopup();
+}
+
+void priv::PanelButton::openPopup()
+{
+    if (m_popup != nullptr)
+    {
+        return;
+    }
+
+    // The collapsed panel itself is moved into the popup, where it is shown
+    // at full size. It keeps its header and menu as logical parents, so its
+    // items still emit their events through the menu.
+    QWidget* popup = new QWidget(this, Qt::Popup);
+    popup->setAutoFillBackground(true);
+    popup->setFocusPolicy(Qt::ClickFocus);
+    popup->setProperty("qoffice_menu", true);
+
+    QHBoxLayout* layout = new QHBoxLayout(popup);
+    layout->setContentsMargins(0,4,0,0);
+    layout->setSpacing(0);
+
+    m_panel->setParent(popup);
+    layout->addWidget(m_panel);
+    m_panel->show();
+
+    m_popup = popup;
+    m_popup->installEventFilter(this);
+    m_popup->move(mapToGlobal(rect().bottomLeft()));
+    m_popup->show();
+    m_popup->setFocus(Qt::PopupFocusReason);
+
+    update();
+}
+
+void priv::PanelButton::closePopup()
+{
+    if (m_popup != nullptr)
+    {
+        m_popup->hide();
+    }
+}
+
+QSize priv::PanelButton::sizeHint() const
+{
+    return QSize(
+        m_panel->tierWidth(OfficeMenuPanel::CollapsedTier),
+        m_panel->sizeHint().height()
+        );
+}
+
+void priv::PanelButton::paintEvent(QPaintEvent*)
+{
+    OffProfileScope("priv::PanelButton::paintEvent");
+
+    QPainter painter(this);
+
+    const QRect textRect = rect().adjusted(0,0,0,-4);
+    const QPoint separatorTop = rect().topRight() + QPoint(0,4);
+    const QPoint separatorBtm = rect().bottomRight() - QPoint(0,4);
+    const QPoint arrowCenter(width() / 2, height() / 2);
+    const QTextOption textOption(Qt::AlignHCenter | Qt::AlignBottom);
+
+    if (m_popup != nullptr)
+    {
+        painter.fillRect(rect(), OfficePalette::color(OfficePalette::MenuItemPress));
+    }
+    else if (m_isHovered && OfficePerformance::isHoverEnabled())
+    {
+        painter.fillRect(rect(), OfficePalette::color(OfficePalette::MenuItemHover));
+    }
+
+    // Text
+    painter.setPen(OfficePalette::color(OfficePalette::Foreground));
+    painter.drawText(textRect, m_panel->text(), textOption);
+
+    // Drop-down arrow
+    const QPoint arrow[3] =
+    {
+        arrowCenter + QPoint(-c_arrowSize, -c_arrowSize / 2),
+        arrowCenter + QPoint( c_arrowSize, -c_arrowSize / 2),
+        arrowCenter + QPoint( 0,            c_arrowSize / 2)
+    };
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setBrush(OfficePalette::color(OfficePalette::Foreground));
+    painter.setPen(Qt::NoPen);
+    painter.drawPolygon(arrow, 3);
+    painter.setRenderHint(QPainter::Antialiasing, false);
+
+    // Separator
+    painter.setPen(OfficePalette::color(OfficePalette::MenuSeparator));
+    painter.drawLine(separatorTop, separatorBtm);
+}
+
+void priv::PanelButton::enterEvent(QEvent* event)
+{
+    m_isHovered = true;
+    if (OfficePerformance::isHoverEnabled())
+    {
+        update();
+    }
+
+    QWidget::enterEvent(event);
+}
+
+void priv::PanelButton::leaveEvent(QEvent* event)
+{
+    m_isHovered = false;
+    if (OfficePerformance::isHoverEnabled())
+    {
+        update();
+    }
+
+    QWidget::leaveEvent(event);
+}
+
+void priv::PanelButton::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton)
+    {
+        openPopup();
+    }
+
+    QWidget::mousePressEvent(event);
+}
+
+bool priv::PanelButton::eventFilter(QObject* obj, QEvent* event)
+{
+    // The popup closes itself when clicking anywhere else.
+    if (obj == m_popup && event->type() == QEvent::Hide)
+    {
+        restorePanel();
+    }
+
+    return QWidget::eventFilter(obj, event);
+}
+
+void priv::PanelButton::restorePanel()
+{
+    QWidget* popup = m_popup;
+    m_popup = nullptr;
+
+    // Moves the panel back into the panel bar, where it stays hidden until
+    // there is enough space for it again.
+    m_panel->hide();
+    m_panel->setParent(parentWidget());
+
+    popup->removeEventFilter(this);
+    popup->deleteLater();
+
+    update();
+}
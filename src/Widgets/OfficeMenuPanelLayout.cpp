@@ -0,0 +1,376 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelLayout.hpp>
+
+#include <QStyle>
+#include <QWidget>
+
+priv::PanelLayout::PanelLayout(QWidget* parent)
+    : QLayout(parent)
+    , m_isDirty(true)
+{
+}
+
+priv::PanelLayout::~PanelLayout()
+{
+    for (const Cell& cell : m_cells)
+    {
+        delete cell.item;
+    }
+}
+
+void priv::PanelLayout::addWidget(
+    QWidget* widget,
+    int row, int column,
+    int rowSpan, int columnSpan
+    )
+{
+    addChildWidget(widget);
+
+    // QWidgetItemV2 caches the size hints of its widget and only drops them
+    // once that very widget changed, which keeps relayouts incremental.
+    addItem(new QWidgetItemV2(widget), row, column, rowSpan, columnSpan);
+}
+
+void priv::PanelLayout::addItem(
+    QLayoutItem* item,
+    int row, int column,
+    int rowSpan, int columnSpan
+    )
+{
+    Cell cell;
+    cell.item = item;
+    cell.row = qMax(row, 0);
+    cell.column = qMax(column, 0);
+    cell.rowSpan = qMax(rowSpan, 1);
+    cell.columnSpan = qMax(columnSpan, 1);
+
+    m_cells.append(cell);
+    invalidate();
+}
+
+void priv::PanelLayout::getItemPosition(
+    int index,
+    int* row, int* column,
+    int* rowSpan, int* columnSpan
+    ) const
+{
+    if (index >= 0 && index < m_cells.size())
+    {
+        const Cell& cell = m_cells.at(index);
+        *row = cell.row;
+        *column = cell.column;
+        *rowSpan = cell.rowSpan;
+        *columnSpan = cell.columnSpan;
+    }
+}
+
+int priv::PanelLayout::rowCount() const
+{
+    if (m_isDirty)
+    {
+        calculate();
+    }
+
+    return m_rows.size();
+}
+
+int priv::PanelLayout::columnCount() const
+{
+    if (m_isDirty)
+    {
+        calculate();
+    }
+
+    return m_columns.size();
+}
+
+void priv::PanelLayout::addItem(QLayoutItem* item)
+{
+    // Items without a cell are appended as new column.
+    addItem(item, 0, columnCount());
+}
+
+int priv::PanelLayout::count() const
+{
+    return m_cells.size();
+}
+
+QLayoutItem* priv::PanelLayout::itemAt(int index) const
+{
+    if (index >= 0 && index < m_cells.size())
+    {
+        return m_cells.at(index).item;
+    }
+
+    return nullptr;
+}
+
+QLayoutItem* priv::PanelLayout::takeAt(int index)
+{
+    if (index < 0 || index >= m_cells.size())
+    {
+        return nullptr;
+    }
+
+    QLayoutItem* item = m_cells.at(index).item;
+    m_cells.remove(index);
+    invalidate();
+
+    return item;
+}
+
+QSize priv::PanelLayout::sizeHint() const
+{
+    if (m_isDirty)
+    {
+        calculate();
+    }
+
+    return m_sizeHint;
+}
+
+QSize priv::PanelLayout::sizeHint(const QVector<QSize>& hints) const
+{
+    QVector<int> columns;
+    QVector<int> rows;
+
+    return measure(hints, columns, rows);
+}
+
+QSize priv::PanelLayout::minimumSize() const
+{
+    // Ribbon cells do not shrink, panels that do not fit are handled by the
+    // panel bar instead.
+    return sizeHint();
+}
+
+Qt::Orientations priv::PanelLayout::expandingDirections() const
+{
+    return 0;
+}
+
+void priv::PanelLayout::setGeometry(const QRect& rect)
+{
+    OffProfileScope("priv::PanelLayout::setGeometry");
+
+    QLayout::setGeometry(rect);
+
+    if (m_isDirty)
+    {
+        calculate();
+    }
+
+    const QRect area = contentsRect();
+    const int space = spacing();
+
+    // Space beyond the size hint is spread evenly, since ribbon cells are
+    // uniform. Copies, so that the cached hints stay untouched.
+    QVector<int> columns = m_columns;
+    QVector<int> rows = m_rows;
+    const int width = extent(columns, 0, columns.size(), space);
+    const int height = extent(rows, 0, rows.size(), space);
+
+    distribute(columns, 0, columns.size(), area.width() - width);
+    distribute(rows, 0, rows.size(), area.height() - height);
+
+    // Offsets of every column and row, computed in one pass each.
+    QVector<int> x(columns.size());
+    QVector<int> y(rows.size());
+
+    for (int i = 0, offset = area.left(); i < columns.size(); ++i)
+    {
+        x[i] = offset;
+        offset += columns.at(i) + space;
+    }
+
+    for (int i = 0, offset = area.top(); i < rows.size(); ++i)
+    {
+        y[i] = offset;
+        offset += rows.at(i) + space;
+    }
+
+    for (const Cell& cell : m_cells)
+    {
+        if (isSkipped(cell.item))
+        {
+            continue;
+        }
+
+        const QRect bounds(
+            x.at(cell.column),
+            y.at(cell.row),
+            extent(columns, cell.column, cell.columnSpan, space),
+            extent(rows, cell.row, cell.rowSpan, space)
+            );
+
+        // Mirrors QGridLayout: items without an alignment fill their cell as
+        // far as they are allowed to and are centered vertically otherwise.
+        Qt::Alignment align = cell.item->alignment();
+        QSize size = bounds.size().boundedTo(cell.item->maximumSize());
+
+        if (align == 0)
+        {
+            align = Qt::AlignLeft | Qt::AlignVCenter;
+        }
+        else
+        {
+            size = size.boundedTo(cell.item->sizeHint());
+        }
+
+        cell.item->setGeometry(QStyle::alignedRect(Qt::LeftToRight, align, size, bounds));
+    }
+}
+
+bool priv::PanelLayout::isSkipped(QLayoutItem* item)
+{
+    // Like QGridLayout, only hidden widgets give up their cell. A spacer is
+    // always empty, yet it reserves its cell, e.g. for a light item.
+    return item->isEmpty() && item->widget() != nullptr;
+}
+
+void priv::PanelLayout::invalidate()
+{
+    m_isDirty = true;
+
+    QLayout::invalidate();
+}
+
+void priv::PanelLayout::calculate() const
+{
+    OffProfileScope("priv::PanelLayout::calculate");
+
+    QVector<QSize> hints;
+    hints.reserve(m_cells.size());
+
+    for (const Cell& cell : m_cells)
+    {
+        hints.append(isSkipped(cell.item) ? QSize() : cell.item->sizeHint());
+    }
+
+    m_sizeHint = measure(hints, m_columns, m_rows);
+    m_isDirty = false;
+}
+
+QSize priv::PanelLayout::measure(
+    const QVector<QSize>& hints,
+    QVector<int>& columns,
+    QVector<int>& rows
+    ) const
+{
+    int columnCount = 0;
+    int rowCount = 0;
+
+    for (const Cell& cell : m_cells)
+    {
+        columnCount = qMax(columnCount, cell.column + cell.columnSpan);
+        rowCount = qMax(rowCount, cell.row + cell.rowSpan);
+    }
+
+    columns.fill(0, columnCount);
+    rows.fill(0, rowCount);
+
+    // Single-cell items determine the size of their column and row directly.
+    // Spanning items are rare and only widen the cells they span afterwards,
+    // instead of solving constraints like QGridLayout does.
+    for (int i = 0; i < m_cells.size(); ++i)
+    {
+        const Cell& cell = m_cells.at(i);
+        const QSize& hint = hints.at(i);
+
+        if (!hint.isValid())
+        {
+            continue;
+        }
+
+        if (cell.columnSpan == 1)
+        {
+            columns[cell.column] = qMax(columns.at(cell.column), hint.width());
+        }
+
+        if (cell.rowSpan == 1)
+        {
+            rows[cell.row] = qMax(rows.at(cell.row), hint.height());
+        }
+    }
+
+    const int space = spacing();
+
+    for (int i = 0; i < m_cells.size(); ++i)
+    {
+        const Cell& cell = m_cells.at(i);
+        const QSize& hint = hints.at(i);
+
+        if (!hint.isValid() || (cell.columnSpan == 1 && cell.rowSpan == 1))
+        {
+            continue;
+        }
+
+        if (cell.columnSpan > 1)
+        {
+            const int width = extent(columns, cell.column, cell.columnSpan, space);
+            distribute(columns, cell.column, cell.columnSpan, hint.width() - width);
+        }
+
+        if (cell.rowSpan > 1)
+        {
+            const int height = extent(rows, cell.row, cell.rowSpan, space);
+            distribute(rows, cell.row, cell.rowSpan, hint.height() - height);
+        }
+    }
+
+    int left, top, right, bottom;
+    getContentsMargins(&left, &top, &right, &bottom);
+
+    return QSize(
+        extent(columns, 0, columnCount, space) + left + right,
+        extent(rows, 0, rowCount, space) + top + bottom
+        );
+}
+
+void priv::PanelLayout::distribute(QVector<int>& sizes, int first, int count, int amount)
+{
+    if (amount <= 0 || count <= 0)
+    {
+        return;
+    }
+
+    // The remainder goes to the first cells, so that the total is exact.
+    for (int i = 0; i < count; ++i)
+    {
+        sizes[first + i] += amount / count + (i < amount % count ? 1 : 0);
+    }
+}
+
+int priv::PanelLayout::extent(const QVector<int>& sizes, int first, int count, int space)
+{
+    int total = 0;
+    for (int i = first; i < first + count && i < sizes.size(); ++i)
+    {
+        total += sizes.at(i);
+    }
+
+    return (count > 0) ? total + space * (count - 1) : 0;
+}
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// QOffice - The office framework for Qt
+// Copyright (C) 2016-2018 Nicolas Kogler
+//
+// This file is part of the Widget module.
+//
+// QOffice is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// QOffice is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with QOffice. If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QOffice/Design/OfficeImage.hpp>
+#include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
+#include <QOffice/Widgets/OfficeMenu.hpp>
+#include <QOffice/Widgets/OfficeMenuPanelSnapshot.hpp>
+
+#include <QPainter>
+
+priv::PanelSnapshot::PanelSnapshot(OfficeMenu* parent)
+    : QWidget(parent)
+{
+    // The snapshot paints every pixel, see PanelSnapshot::paintEvent.
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    hide();
+}
+
+void priv::PanelSnapshot::capture(QWidget* widget)
+{
+    OffProfileScope("priv::PanelSnapshot::capture");
+
+    // Lays out the widget once at its final size and renders it, even if it is
+    // hidden. The pixmap carries the device pixel ratio of the widget.
+    widget->layout()->activate();
+    m_pixmap = widget->grab();
+}
+
+void priv::PanelSnapshot::release()
+{
+    hide();
+    m_pixmap = QPixmap();
+}
+
+void priv::PanelSnapshot::paintEvent(QPaintEvent*)
+{
+    OffProfileScope("priv::PanelSnapshot::paintEvent");
+
+    // Only the top part of the snapshot that fits the current size is drawn,
+    // which reveals the panel bar from top to bottom.
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_pixmap);
+
+    // The menu might have been resized since the snapshot was taken.
+    const QSize size = OfficeImage::logicalSize(m_pixmap);
+    const QRect remainder(size.width(), 0, width() - size.width(), height());
+
+    if (!remainder.isEmpty())
+    {
+        painter.fillRect(remainder, OfficePalette::color(OfficePalette::Background));
+    }
+}
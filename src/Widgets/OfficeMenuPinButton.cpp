@@ -20,7 +20,10 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <QOffice/Design/OfficeImage.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 #include <QOffice/Widgets/OfficeMenu.hpp>
 #include <QOffice/Widgets/OfficeMenuHeader.hpp>
 #include <QOffice/Widgets/OfficeMenuPinButton.hpp>
@@ -29,17 +32,16 @@
 #include <QPainter>
 #include <QMouseEvent>
 
-OffAnonymous(bool g_isSticky = false)
-
 priv::PinButton::PinButton(OfficeMenuHeader* parent)
     : QWidget(parent)
     , m_parent(parent)
     , m_tooltip(new OfficeTooltip)
-    , m_imgSticky(":/qoffice/images/widgets/menu_sticky.png")
-    , m_imgCollapse(":/qoffice/images/widgets/menu_collapse.png")
+    , m_imageRatio(0.0)
     , m_isHovered(false)
     , m_isPressed(false)
 {
+    loadImages(devicePixelRatioF());
+
     setFixedSize(30, 16);
     setMinimumSize(30, 16);
     setMaximumSize(30, 16);
@@ -61,18 +63,25 @@ QSize priv::PinButton::sizeHint() const
 
 void priv::PinButton::paintEvent(QPaintEvent*)
 {
+    OffProfileScope("priv::PinButton::paintEvent");
+
+    if (m_imageRatio != devicePixelRatioF())
+    {
+        loadImages(devicePixelRatioF());
+    }
+
     QPainter painter(this);
 
     if (m_isPressed)
     {
         painter.fillRect(rect(), OfficePalette::color(OfficePalette::MenuItemPress));
     }
-    else if (m_isHovered)
+    else if (m_isHovered && OfficePerformance::isHoverEnabled())
     {
         painter.fillRect(rect(), OfficePalette::color(OfficePalette::MenuItemHover));
     }
 
-    if (!g_isSticky)
+    if (!m_parent->menu()->isPinned())
     {
         painter.drawPixmap(QPoint(), m_imgSticky);
     }
@@ -88,7 +97,7 @@ void priv::PinButton::enterEvent(QEvent* event)
     m_tooltip->move(QCursor::pos());
     m_tooltip->resize(200, 100);
 
-    if (!g_isSticky)
+    if (!m_parent->menu()->isPinned())
     {
         m_tooltip->setTitle("Pin");
         m_tooltip->setText("Pins the ribbon bar and makes it permanent.");
@@ -103,9 +112,8 @@ void priv::PinButton::enterEvent(QEvent* event)
     // causing it to collapse. We temporarily "pin" the menu for that purpose.
     m_parent->menu()->m_isTooltipShown = true;
     m_tooltip->show();
-    m_isHovered = true;
 
-    update();
+    setHovered(true);
 
     QWidget::enterEvent(event);
 }
@@ -114,16 +122,36 @@ void priv::PinButton::leaveEvent(QEvent* event)
 {
     m_parent->menu()->m_isTooltipShown = false;
     m_tooltip->hide();
-    m_isHovered = false;
 
-    update();
+    setHovered(false);
 
     QWidget::leaveEvent(event);
 }
 
+void priv::PinButton::loadImages(qreal ratio)
+{
+    m_imageRatio  = ratio;
+    m_imgSticky   = OfficeImage::loadPixmap(":/qoffice/images/widgets/menu_sticky.png", ratio);
+    m_imgCollapse = OfficeImage::loadPixmap(":/qoffice/images/widgets/menu_collapse.png", ratio);
+}
+
+void priv::PinButton::setHovered(bool hovered)
+{
+    if (m_isHovered != hovered)
+    {
+        m_isHovered = hovered;
+
+        // While being pressed, the hover state is not visible at all.
+        if (!m_isPressed && OfficePerformance::isHoverEnabled())
+        {
+            update();
+        }
+    }
+}
+
 void priv::PinButton::mousePressEvent(QMouseEvent* event)
 {
-    if (event->button() == Qt::LeftButton)
+    if (event->button() == Qt::LeftButton && !m_isPressed)
     {
         m_isPressed = true;
         update();
@@ -134,15 +162,23 @@ void priv::PinButton::mousePressEvent(QMouseEvent* event)
 
 void priv::PinButton::mouseReleaseEvent(QMouseEvent* event)
 {
+    bool changed = m_isPressed;
     if (rect().contains(event->pos()) && event->button() == Qt::LeftButton)
     {
-        g_isSticky = !g_isSticky;
-        m_parent->menu()->setPinned(g_isSticky);
+        // The pinned state belongs to the menu, so several menus do not
+        // interfere with each other.
+        OfficeMenu* menu = m_parent->menu();
+        menu->setPinned(!menu->isPinned());
+        changed = true;
     }
 
     m_tooltip->hide();
     m_isPressed = false;
-    update();
+
+    if (changed)
+    {
+        update();
+    }
 
     QWidget::mouseReleaseEvent(event);
 }
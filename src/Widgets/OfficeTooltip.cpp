@@ -20,8 +20,11 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <QOffice/Design/OfficeAnimationClock.hpp>
 #include <QOffice/Design/OfficeImage.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 #include <QOffice/Widgets/OfficeTooltip.hpp>
 #include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
 
@@ -32,83 +35,37 @@
 #include <QPainter>
 #include <QScreen>
 
-OffAnonymous(QOFFICE_CONSTEXPR int c_margin  = c_shadowPadding + 10)
-OffAnonymous(QOFFICE_CONSTEXPR int c_padding = c_margin * 2)
+OffAnonymous(QOFFICE_CONSTEXPR int c_fadeDuration = 200)
+OffAnonymous(QOFFICE_CONSTEXPR int c_leaveDelay = 400)
+OffAnonymous(QOFFICE_CONSTEXPR int c_textMargin = 10)
 OffAnonymous(QOFFICE_CONSTEXPR int c_bodyMargin = 10)
 OffAnonymous(QOFFICE_CONSTEXPR int c_iconMargin = 8)
 OffAnonymous(QOFFICE_CONSTEXPR int c_helpMargin = 7)
 OffAnonymous(QOFFICE_CONSTEXPR int c_separator  = 9)
+OffAnonymous(const char* const c_helpIconPath = ":/qoffice/images/widgets/tooltip_help.png")
 
 OfficeTooltip::OfficeTooltip()
     : QWidget(nullptr)
-    , m_timer(new QTimer(this))
-    , m_waitTimer(new QTimer(this))
-    , m_showAnimation(new QPropertyAnimation(this, "Opacity"))
-    , m_hideAnimation(new QPropertyAnimation(this, "Opacity"))
+    , m_fadeAnimation(0)
     , m_activeWindow(nullptr)
     , m_heading("")
     , m_bodyText("Text")
     , m_helpText("")
-    , m_helpIcon(":/qoffice/images/widgets/tooltip_help.png")
+    , m_helpIcon(OfficeImage::loadPixmap(c_helpIconPath, qApp->devicePixelRatio()))
     , m_duration(4000)
+    , m_waitPeriod(0)
     , m_helpKey(Qt::Key_F1)
     , m_opacity(0.0)
     , m_isHelpEnabled(false)
     , m_isLinkHovered(false)
+    , m_isDefaultIcon(true)
+    , m_isTranslucent(OfficePerformance::isTranslucencyEnabled())
+    , m_isWaiting(false)
 {
-    m_timer->setSingleShot(true);
-    m_waitTimer->setSingleShot(true);
-
     // Tells Qt that our widget is a tooltip and should be frameless.
     setWindowFlags(Qt::ToolTip | Qt::FramelessWindowHint);
-    setAttribute(Qt::WA_TranslucentBackground);
+    setAttribute(Qt::WA_TranslucentBackground, m_isTranslucent);
     setMouseTracking(true);
-
-    // Show animation
-    m_showAnimation->setDuration(200);
-    m_showAnimation->setStartValue(0.0);
-    m_showAnimation->setEndValue(1.0);
-
-    // Hide animation
-    m_hideAnimation->setDuration(200);
-    m_hideAnimation->setStartValue(1.0);
-    m_hideAnimation->setEndValue(0.0);
-
-    // Need to use old syntax since update() has overloads :(
-    QObject::connect(
-        m_showAnimation,
-        SIGNAL(valueChanged(QVariant)),
-        this,
-        SLOT(update())
-        );
-
-    QObject::connect(
-        m_hideAnimation,
-        SIGNAL(valueChanged(QVariant)),
-        this,
-        SLOT(update())
-        );
-
-    QObject::connect(
-        m_timer,
-        &QTimer::timeout,
-        this,
-        &OfficeTooltip::beginHideTooltip
-        );
-
-    QObject::connect(
-        m_waitTimer,
-        &QTimer::timeout,
-        this,
-        &OfficeTooltip::fadeInTooltip
-        );
-
-    QObject::connect(
-        m_hideAnimation,
-        &QPropertyAnimation::finished,
-        this,
-        &OfficeTooltip::emitTooltipHidden
-        );
 }
 
 const QString& OfficeTooltip::title() const
@@ -174,6 +131,7 @@ void OfficeTooltip::setHelpText(const QString& text)
 void OfficeTooltip::setHelpIcon(const QPixmap& icon)
 {
     m_helpIcon = icon;
+    m_isDefaultIcon = false;
 }
 
 void OfficeTooltip::setHelpKey(Qt::Key trigger)
@@ -191,8 +149,45 @@ void OfficeTooltip::setWaitPeriod(int milliseconds)
     m_waitPeriod = milliseconds;
 }
 
+void OfficeTooltip::setVisible(bool visible)
+{
+    // A translucent tooltip waits at zero opacity, whereas an opaque one would
+    // show its bare background, hence it is not even mapped while waiting.
+    if (visible && !isVisible() && !m_isTranslucent && m_waitPeriod != 0)
+    {
+        if (!m_isWaiting || !m_timer.isActive())
+        {
+            restartTimer(m_waitPeriod, true);
+        }
+
+        return;
+    }
+
+    if (!visible)
+    {
+        m_timer.stop();
+    }
+
+    QWidget::setVisible(visible);
+}
+
 void OfficeTooltip::paintEvent(QPaintEvent*)
 {
+    OffProfileScope("OfficeTooltip::paintEvent");
+
+    // The tooltip is only known to be on its final screen once it is shown,
+    // the device pixel ratio of which might differ from the one of creation.
+    const qreal ratio = devicePixelRatioF();
+    if (m_isTranslucent && m_dropShadow.devicePixelRatio() != ratio)
+    {
+        generateDropShadow();
+    }
+
+    if (m_isDefaultIcon && m_helpIcon.devicePixelRatio() != ratio)
+    {
+        m_helpIcon = OfficeImage::loadPixmap(c_helpIconPath, ratio);
+    }
+
     QPainter painter(this);
 
     // Retrieves a standardized set of colors for this tooltip.
@@ -204,7 +199,10 @@ void OfficeTooltip::paintEvent(QPaintEvent*)
 
     // Drop-shadow
     painter.setOpacity(m_opacity);
-    painter.drawPixmap(QPoint(), m_dropShadow);
+    if (m_isTranslucent)
+    {
+        painter.drawPixmap(QPoint(), m_dropShadow);
+    }
 
     // Background and border
     painter.setPen(colorBorder);
@@ -243,7 +241,7 @@ void OfficeTooltip::paintEvent(QPaintEvent*)
         painter.drawPixmap(m_iconRectangle, m_helpIcon);
         painter.drawText(m_helpRectangle, m_helpText);
 
-        if (m_isLinkHovered)
+        if (m_isLinkHovered && OfficePerformance::isHoverEnabled())
         {
             QPoint p1(m_helpRectangle.left(),  m_helpRectangle.bottom());
             QPoint p2(m_helpRectangle.right(), m_helpRectangle.bottom());
@@ -270,7 +268,7 @@ void OfficeTooltip::mouseMoveEvent(QMouseEvent* event)
             unsetCursor();
         }
 
-        if (m_isLinkHovered != previousState)
+        if (m_isLinkHovered != previousState && OfficePerformance::isHoverEnabled())
         {
             update();
         }
@@ -326,12 +324,11 @@ void OfficeTooltip::showEvent(QShowEvent*)
         }
     }
 
-    if (m_waitPeriod != 0)
+    if (m_waitPeriod != 0 && m_isTranslucent)
     {
         // If we specified a wait period, we do not fade in the tooltip yet. The
         // actual widget, however, will be practically shown nonetheless.
-        m_waitTimer->setInterval(m_waitPeriod);
-        m_waitTimer->start();
+        restartTimer(m_waitPeriod, true);
     }
     else
     {
@@ -346,10 +343,8 @@ void OfficeTooltip::hideEvent(QHideEvent*)
         m_activeWindow->m_tooltipVisible = false;
     }
 
-    m_timer->stop();
-    m_waitTimer->stop();
-    m_showAnimation->stop();
-    m_hideAnimation->stop();
+    m_timer.stop();
+    OfficeAnimationClock::stop(m_fadeAnimation);
 
     m_opacity = 0.0;
     m_isLinkHovered = false;
@@ -358,15 +353,49 @@ void OfficeTooltip::hideEvent(QHideEvent*)
 
 void OfficeTooltip::leaveEvent(QEvent*)
 {
-    m_timer->setInterval(400);
-    m_timer->start();
+    restartTimer(c_leaveDelay, false);
 
     unsetCursor();
 }
 
+void OfficeTooltip::timerEvent(QTimerEvent* event)
+{
+    if (event->timerId() != m_timer.timerId())
+    {
+        QWidget::timerEvent(event);
+        return;
+    }
+
+    // The wait period and the display duration never overlap, therefore one
+    // timer serves both of them.
+    m_timer.stop();
+    if (m_isWaiting)
+    {
+        fadeInTooltip();
+    }
+    else
+    {
+        beginHideTooltip();
+    }
+}
+
 void OfficeTooltip::beginHideTooltip()
 {
-    m_hideAnimation->start();
+    const int duration = OfficePerformance::isAnimationEnabled() ? c_fadeDuration : 0;
+    const qreal opacity = m_opacity;
+
+    // Fades out from the current opacity, which is less than one if the fade
+    // in is interrupted.
+    OfficeAnimationClock::stop(m_fadeAnimation);
+    m_fadeAnimation = OfficeAnimationClock::start(
+        this,
+        duration,
+        [this, opacity](qreal progress)
+        {
+            m_opacity = opacity * (1.0 - progress);
+            update();
+        },
+        [this]() { emitTooltipHidden(); });
 }
 
 void OfficeTooltip::emitTooltipHidden()
@@ -378,8 +407,15 @@ void OfficeTooltip::emitTooltipHidden()
 
 void OfficeTooltip::fadeInTooltip()
 {
-    m_timer->setInterval(m_duration);
-    m_timer->start();
+    if (!isVisible())
+    {
+        // The wait period of an opaque tooltip is over. Showing it calls this
+        // function once again, see OfficeTooltip::showEvent.
+        QWidget::setVisible(true);
+        return;
+    }
+
+    restartTimer(m_duration, false);
 
     updateRectangles();
 
@@ -408,22 +444,36 @@ void OfficeTooltip::fadeInTooltip()
     activateWindow();
     setFocus(Qt::PopupFocusReason);
 
-    m_opacity = 0.0;
-    m_showAnimation->start();
+    const int duration = OfficePerformance::isAnimationEnabled() ? c_fadeDuration : 0;
+
+    OfficeAnimationClock::stop(m_fadeAnimation);
+    m_fadeAnimation = OfficeAnimationClock::start(
+        this,
+        duration,
+        [this](qreal progress)
+        {
+            m_opacity = progress;
+            update();
+        });
 
     emit tooltipShown();
 }
 
 void OfficeTooltip::updateRectangles()
 {
+    OffProfileScope("OfficeTooltip::updateRectangles");
+
     QFont normFont = font(); normFont.setBold(false);
     QFont boldFont = font(); boldFont.setBold(true);
 
     QFontMetrics normMetrics(normFont);
     QFontMetrics boldMetrics(boldFont);
 
-    int currentX = c_margin;
-    int currentY = c_margin;
+    const int margin  = shadowPadding() + c_textMargin;
+    const int padding = margin * 2;
+
+    int currentX = margin;
+    int currentY = margin;
 
     // Title
     if (!m_heading.isEmpty())
@@ -440,7 +490,7 @@ void OfficeTooltip::updateRectangles()
     // Body
     if (!m_bodyText.isEmpty())
     {
-        QRect max(0, 0, width() - c_padding, 300);
+        QRect max(0, 0, width() - padding, 300);
         QRect bounds = normMetrics.boundingRect(max, Qt::TextWordWrap, m_bodyText);
 
         m_bodyRectangle.setX(currentX);
@@ -458,16 +508,16 @@ void OfficeTooltip::updateRectangles()
         // Separator
         m_sepaRectangle.setX(currentX);
         m_sepaRectangle.setY(currentY);
-        m_sepaRectangle.setSize(QSize(width() - c_padding, 1));
+        m_sepaRectangle.setSize(QSize(width() - padding, 1));
 
         currentY += c_separator;
 
         // Icon
         m_iconRectangle.setX(currentX);
         m_iconRectangle.setY(currentY);
-        m_iconRectangle.setSize(m_helpIcon.size());
+        m_iconRectangle.setSize(OfficeImage::logicalSize(m_helpIcon));
 
-        currentX += (m_helpIcon.width() + c_iconMargin);
+        currentX += (m_iconRectangle.width() + c_iconMargin);
 
         // Text
         m_helpRectangle.setX(currentX);
@@ -478,14 +528,19 @@ void OfficeTooltip::updateRectangles()
         currentY += m_helpRectangle.height();
     }
 
-    currentY += c_margin;
+    currentY += margin;
     resize(width(), currentY);
-    generateDropShadow();
+
+    if (m_isTranslucent)
+    {
+        generateDropShadow();
+    }
 
     // Client
-    m_clientRectangle.setTopLeft(QPoint(c_shadowPadding, c_shadowPadding));
-    m_clientRectangle.setWidth(width() - c_shadowPadding * 2);
-    m_clientRectangle.setHeight(height() - c_shadowPadding * 2);
+    const int shadow = shadowPadding();
+    m_clientRectangle.setTopLeft(QPoint(shadow, shadow));
+    m_clientRectangle.setWidth(width() - shadow * 2);
+    m_clientRectangle.setHeight(height() - shadow * 2);
 
     // Border
     m_borderRectangle = m_clientRectangle.adjusted(0,0,-1,-1);
@@ -493,15 +548,16 @@ void OfficeTooltip::updateRectangles()
 
 void OfficeTooltip::generateDropShadow()
 {
-    m_dropShadow = OfficeImage::generateDropShadow(size());
+    m_dropShadow = OfficeImage::generateDropShadow(size(), devicePixelRatioF());
 }
 
-qreal OfficeTooltip::opacity() const
+int OfficeTooltip::shadowPadding() const
 {
-    return m_opacity;
+    return m_isTranslucent ? c_shadowPadding : 0;
 }
 
-void OfficeTooltip::setOpacity(qreal opacity)
+void OfficeTooltip::restartTimer(int milliseconds, bool isWaiting)
 {
-    m_opacity = opacity;
+    m_isWaiting = isWaiting;
+    m_timer.start(milliseconds, this);
 }
@@ -21,7 +21,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <QOffice/Design/OfficeAccent.hpp>
+#include <QOffice/Design/OfficeImage.hpp>
 #include <QOffice/Design/OfficePalette.hpp>
+#include <QOffice/Design/OfficePerformance.hpp>
+#include <QOffice/Design/OfficeProfiler.hpp>
 #include <QOffice/Widgets/OfficeWindowMenu.hpp>
 #include <QOffice/Widgets/OfficeWindowMenuItem.hpp>
 #include <QOffice/Widgets/Dialogs/OfficeWindow.hpp>
@@ -29,14 +32,6 @@
 #include <QPainter>
 #include <QtEvents>
 
-QRect centerRectangle(const QPixmap& pm, const QRect& rc)
-{
-    int dx = (rc.width()  - pm.width())  / 2;
-    int dy = (rc.height() - pm.height()) / 2;
-
-    return QRect(rc.x() + dx, rc.y() + dy, pm.width(), pm.height());
-}
-
 priv::WindowItem::WindowItem(
     OfficeWindowMenu* parent,
     int type,
@@ -118,6 +113,7 @@ QSize priv::WindowItem::sizeHint() const
 void priv::WindowItem::enterEvent(QEvent* event)
 {
     m_isHovered = true;
+    updateHoverRegion();
 
     emit tooltipShowRequested(this);
 
@@ -127,6 +123,7 @@ void priv::WindowItem::enterEvent(QEvent* event)
 void priv::WindowItem::leaveEvent(QEvent* event)
 {
     m_isHovered = false;
+    updateHoverRegion();
 
     emit tooltipHideRequested(this);
 
@@ -135,12 +132,14 @@ void priv::WindowItem::leaveEvent(QEvent* event)
 
 void priv::WindowItem::paintEvent(QPaintEvent*)
 {
+    OffProfileScope("priv::WindowItem::paintEvent");
+
     QPainter painter(this);
 
     if (m_type == OfficeWindowMenu::LabelMenu)
     {
         auto currentFont = font();
-        if (m_isHovered)
+        if (m_isHovered && OfficePerformance::isHoverEnabled())
         {
             currentFont.setUnderline(true);
         }
@@ -169,12 +168,12 @@ void priv::WindowItem::paintEvent(QPaintEvent*)
         {
             painter.fillRect(rect(), OfficeAccent::darkColor(accent));
         }
-        else if (m_isHovered)
+        else if (m_isHovered && OfficePerformance::isHoverEnabled())
         {
             painter.fillRect(rect(), OfficeAccent::lightColor(accent));
         }
 
-        painter.drawPixmap(centerRectangle(m_image, rect()), m_image);
+        painter.drawPixmap(OfficeImage::centerRectangle(m_image, rect()), m_image);
     }
 }
 
@@ -182,8 +181,7 @@ void priv::WindowItem::mousePressEvent(QMouseEvent* event)
 {
     if (event->button() == Qt::LeftButton)
     {
-        m_isPressed = true;
-        update();
+        setPressed(true);
 
         emit clicked(this);
     }
@@ -195,8 +193,39 @@ void priv::WindowItem::mousePressEvent(QMouseEvent* event)
 
 void priv::WindowItem::mouseReleaseEvent(QMouseEvent* event)
 {
-    m_isPressed = false;
-    update();
+    setPressed(false);
 
     QWidget::mouseReleaseEvent(event);
 }
+
+void priv::WindowItem::setPressed(bool pressed)
+{
+    if (m_isPressed != pressed)
+    {
+        m_isPressed = pressed;
+
+        // Only the items of the quick menu have a pressed look.
+        if (m_type == OfficeWindowMenu::QuickMenu)
+        {
+            update();
+        }
+    }
+}
+
+void priv::WindowItem::updateHoverRegion()
+{
+    if (!OfficePerformance::isHoverEnabled())
+    {
+        return;
+    }
+
+    if (m_type == OfficeWindowMenu::LabelMenu)
+    {
+        // Labels merely underline their text when being hovered.
+        update(fontMetrics().boundingRect(rect(), 0, m_text));
+    }
+    else
+    {
+        update();
+    }
+}